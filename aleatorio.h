@@ -0,0 +1,28 @@
+#ifndef ALEATORIO_H
+#define ALEATORIO_H
+
+#include <cstdint>
+
+// Números pseudoaleatórios sem estado, usados pelos geradores (cidade, demanda) e pelo benchmark:
+// cada sorteio é misturar(semente ^ contador), então o resultado não depende da ordem nem do
+// número de threads.
+
+// Finalizador do splitmix64: bijeção que espalha bem contadores consecutivos
+inline uint64_t misturar(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// Uniforme em [0, 1) a partir dos 53 bits altos
+inline double uniforme(uint64_t aleatorio) {
+    return (aleatorio >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// Uniforme em (0, 1] a partir dos 32 bits altos (nunca zero: pode ir para log)
+inline double uniformePositivo(uint64_t aleatorio) {
+    return ((aleatorio >> 32) + 1.0) / 4294967296.0;
+}
+
+#endif // ALEATORIO_H
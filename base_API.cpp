@@ -1,106 +1,433 @@
-#include "Graph.h"  // Supondo que a classe Graph esteja aqui
+#include "external/json.hpp"
+#include "eventLog.h"
+#include "graph.h"
 #include <iostream>
+#include <fstream>
 #include <vector>
 #include <string>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <unordered_map>
 #include <functional>
 #include <chrono>
 #include <thread>
 #include <random>
-#include <future>  // Para usar std::future
+#include <queue>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+#include <limits>
+#include <algorithm>
 
 using namespace std;
+using json = nlohmann::json;
+
+// Agente da simulação: só índices para os arrays de passos compartilhados do Simulador, para
+// caber milhões na memória. Os passos do agente são [inicio, fim); o primeiro é o cruzamento de partida.
+struct Agente {
+    int32_t inicio;
+    int32_t fim;
+    float partida;  // Segundo do dia em que sai do primeiro cruzamento
+    int32_t passo;  // Próximo passo a ser alcançado
+};
+
+// Chegada de um agente ao cruzamento do seu passo atual, no tempo simulado `tempo` (segundos)
+struct Evento {
+    double tempo;
+    int32_t agente;
+
+    bool operator>(const Evento& other) const {
+        if (tempo != other.tempo) return tempo > other.tempo;
+        return agente > other.agente;
+    }
+};
+
+// Barreira reutilizável entre as fases de cada janela de tempo (C++17 não tem std::barrier)
+class Barreira {
+public:
+    explicit Barreira(int total) : m_total(total) {}
+
+    void esperar() {
+        unique_lock<mutex> lock(m_mutex);
+        int geracao = m_geracao;
+        if (++m_chegaram == m_total) {
+            m_chegaram = 0;
+            ++m_geracao;
+            m_cv.notify_all();
+        } else {
+            m_cv.wait(lock, [&] { return geracao != m_geracao; });
+        }
+    }
+
+private:
+    mutex m_mutex;
+    condition_variable m_cv;
+    int m_total;
+    int m_chegaram = 0;
+    int m_geracao = 0;
+};
+
+// Simulação de eventos discretos: uma fila global ordenada pelo tempo simulado substitui a
+// thread com sleep por pessoa. Cada evento move um agente por uma rua e agenda a próxima
+// chegada, então o custo é O(log n) por rua percorrida e não depende da duração da viagem.
+class Simulador {
+public:
+    // Adiciona um agente que sai de caminho[0] no segundo `partida`; duracoes[i] é o tempo
+    // da rua que chega em caminho[i] (duracoes[0] é ignorada). Retorna o índice do agente.
+    int adicionar_agente(const vector<vertex>& caminho, const vector<float>& duracoes, double partida) {
+        if (caminho.empty() || caminho.size() != duracoes.size()) {
+            cerr << "Caminho invalido para o agente" << endl;
+            return -1;
+        }
+        Agente agente;
+        agente.inicio = m_cruzamento.size();
+        agente.fim = agente.inicio + caminho.size();
+        agente.partida = partida;
+        agente.passo = agente.inicio;
+        m_cruzamento.insert(m_cruzamento.end(), caminho.begin(), caminho.end());
+        m_duracao.insert(m_duracao.end(), duracoes.begin(), duracoes.end());
+        m_duracao[agente.inicio] = 0;
+        m_agentes.push_back(agente);
+        return m_agentes.size() - 1;
+    }
+
+    int getNumAgentes() const { return m_agentes.size(); }
+    const Agente& getAgente(int i) const { return m_agentes[i]; }
+    size_t getNumEventos() const { return m_numEventos; }
+
+    // Processa todos os eventos em ordem de tempo simulado, chamando
+    // ao_chegar(agente, cruzamento, tempo, terminou) a cada chegada (inclusive na partida).
+    // fatorTempo é quantos segundos simulados passam por segundo real: 1 reproduz o tempo real,
+    // 60 roda um minuto por segundo e 0 processa os eventos o mais rápido possível.
+    template<class AoChegar>
+    void executar(double fatorTempo, AoChegar&& ao_chegar) {
+        priority_queue<Evento, vector<Evento>, greater<Evento>> fila;
+        for (int32_t a = 0; a < (int32_t)m_agentes.size(); ++a) {
+            m_agentes[a].passo = m_agentes[a].inicio;
+            fila.push({m_agentes[a].partida, a});
+        }
+        if (fila.empty()) return;
+
+        const double tempoInicial = fila.top().tempo;
+        const auto inicioReal = chrono::steady_clock::now();
+        while (!fila.empty()) {
+            Evento evento = fila.top();
+            fila.pop();
+
+            if (fatorTempo > 0) {
+                // Espera até o relógio real alcançar o tempo simulado escalado
+                this_thread::sleep_until(inicioReal + chrono::duration_cast<chrono::steady_clock::duration>(
+                    chrono::duration<double>((evento.tempo - tempoInicial) / fatorTempo)));
+            }
+
+            Agente& agente = m_agentes[evento.agente];
+            int32_t passo = agente.passo++;
+            bool terminou = agente.passo == agente.fim;
+            ++m_numEventos;
+            ao_chegar(evento.agente, m_cruzamento[passo], evento.tempo, terminou);
+            if (!terminou) {
+                fila.push({evento.tempo + m_duracao[agente.passo], evento.agente});
+            }
+        }
+    }
+
+    // Região (0..numRegioes-1) de cada cruzamento, usada para particionar a execução paralela
+    void definir_regioes(const vector<int32_t>& regiaoDoCruzamento) {
+        m_regiao = regiaoDoCruzamento;
+        m_numRegioes = 0;
+        for (int32_t r : m_regiao) m_numRegioes = max(m_numRegioes, r + 1);
+    }
+
+    // Execução paralela: os eventos ficam em partições (região do cruzamento de chegada x
+    // subdivisão do agente), cada uma com sua fila. O tempo avança em janelas do tamanho da
+    // menor rua: nenhum evento de uma janela gera outro na mesma janela em outra partição, então
+    // as partições de uma janela são independentes. Agentes que cruzam a fronteira da região vão
+    // para a caixa de saída do trabalhador e entram na fila do destino na janela seguinte.
+    // Cada trabalhador começa com as partições distribuídas em rodízio e, sem trabalho próprio,
+    // rouba do início da fila dos outros. ao_chegar(trabalhador, agente, cruzamento, tempo,
+    // terminou) é chamada em paralelo e deve acumular por trabalhador.
+    template<class AoChegar>
+    void executar_paralelo(int numTrabalhadores, int subdivisoes, double fatorTempo, AoChegar&& ao_chegar) {
+        const double INF = numeric_limits<double>::infinity();
+        const int W = max(1, numTrabalhadores);
+        const int S = max(1, subdivisoes);
+        const int P = max(1, m_numRegioes) * S;
+        auto particaoDe = [&](int32_t agente, int32_t passo) {
+            int32_t regiao = m_regiao.empty() ? 0 : m_regiao[m_cruzamento[passo]];
+            return regiao * S + agente % S;
+        };
+
+        // Janela: menor tempo de rua positivo (lookahead conservador)
+        double janela = INF;
+        for (const Agente& agente : m_agentes) {
+            for (int32_t i = agente.inicio + 1; i < agente.fim; ++i) {
+                if (m_duracao[i] > 0) janela = min(janela, (double)m_duracao[i]);
+            }
+        }
+        if (janela == INF) janela = 1.0;
+
+        vector<vector<Evento>> filas(P);
+        for (int32_t a = 0; a < (int32_t)m_agentes.size(); ++a) {
+            m_agentes[a].passo = m_agentes[a].inicio;
+            filas[particaoDe(a, m_agentes[a].inicio)].push_back({m_agentes[a].partida, a});
+        }
+        vector<double> proximo(P, INF);
+        for (int p = 0; p < P; ++p) {
+            make_heap(filas[p].begin(), filas[p].end(), greater<Evento>());
+            if (!filas[p].empty()) proximo[p] = filas[p].front().tempo;
+        }
+        double tempoInicial = *min_element(proximo.begin(), proximo.end());
+        if (tempoInicial == INF) return;
+
+        // Caixas de saída por (trabalhador, partição de destino), em dois buffers: os trabalhadores
+        // escrevem em um enquanto a janela esvazia o outro
+        vector<vector<Evento>> saidas[2] = {vector<vector<Evento>>((size_t)W * P), vector<vector<Evento>>((size_t)W * P)};
+        vector<double> minSaida(W, INF);
+        vector<size_t> eventos(W, 0);
+        vector<deque<int>> tarefas(W);
+        unique_ptr<mutex[]> mutexTarefas(new mutex[W]);
+        Barreira barreira(W);
+        int fase = 0;
+        double fimJanela = 0;
+        bool acabou = false;
+        const auto inicioReal = chrono::steady_clock::now();
+
+        // Fase serial entre as janelas: escolhe o início da próxima janela e distribui as partições com trabalho
+        auto planejar = [&]() {
+            double inicio = INF;
+            for (int p = 0; p < P; ++p) inicio = min(inicio, proximo[p]);
+            for (int w = 0; w < W; ++w) {
+                inicio = min(inicio, minSaida[w]);
+                minSaida[w] = INF;
+            }
+            if (inicio == INF) {
+                acabou = true;
+                return;
+            }
+            fase ^= 1;  // Esta janela esvazia as saídas da anterior
+            fimJanela = inicio + janela;
+            if (fatorTempo > 0) {
+                this_thread::sleep_until(inicioReal + chrono::duration_cast<chrono::steady_clock::duration>(
+                    chrono::duration<double>((inicio - tempoInicial) / fatorTempo)));
+            }
+            int dono = 0;
+            for (int p = 0; p < P; ++p) {
+                bool temEntrada = false;
+                for (int w = 0; w < W && !temEntrada; ++w) temEntrada = !saidas[fase][(size_t)w * P + p].empty();
+                if (proximo[p] < fimJanela || temEntrada) tarefas[dono++ % W].push_back(p);
+            }
+        };
+
+        auto pegarTarefa = [&](int w) {
+            for (int k = 0; k < W; ++k) {
+                int alvo = (w + k) % W;
+                lock_guard<mutex> lock(mutexTarefas[alvo]);
+                if (tarefas[alvo].empty()) continue;
+                int p;
+                if (k == 0) {
+                    p = tarefas[alvo].back();
+                    tarefas[alvo].pop_back();
+                } else {
+                    p = tarefas[alvo].front();  // Roubo
+                    tarefas[alvo].pop_front();
+                }
+                return p;
+            }
+            return -1;
+        };
+
+        auto processar = [&](int p, int w) {
+            vector<Evento>& fila = filas[p];
+            for (int u = 0; u < W; ++u) {
+                vector<Evento>& entrada = saidas[fase][(size_t)u * P + p];
+                for (const Evento& e : entrada) {
+                    fila.push_back(e);
+                    push_heap(fila.begin(), fila.end(), greater<Evento>());
+                }
+                entrada.clear();
+            }
+            while (!fila.empty() && fila.front().tempo < fimJanela) {
+                pop_heap(fila.begin(), fila.end(), greater<Evento>());
+                Evento evento = fila.back();
+                fila.pop_back();
+
+                Agente& agente = m_agentes[evento.agente];
+                int32_t passo = agente.passo++;
+                bool terminou = agente.passo == agente.fim;
+                ++eventos[w];
+                ao_chegar(w, evento.agente, m_cruzamento[passo], evento.tempo, terminou);
+                if (terminou) continue;
+
+                Evento seguinte{evento.tempo + m_duracao[agente.passo], evento.agente};
+                int destino = particaoDe(evento.agente, agente.passo);
+                if (destino == p) {
+                    fila.push_back(seguinte);
+                    push_heap(fila.begin(), fila.end(), greater<Evento>());
+                } else {
+                    saidas[fase ^ 1][(size_t)w * P + destino].push_back(seguinte);
+                    minSaida[w] = min(minSaida[w], seguinte.tempo);
+                }
+            }
+            proximo[p] = fila.empty() ? INF : fila.front().tempo;
+        };
+
+        auto trabalhador = [&](int w) {
+            while (true) {
+                if (w == 0) planejar();
+                barreira.esperar();
+                if (acabou) return;
+                for (int p = pegarTarefa(w); p != -1; p = pegarTarefa(w)) processar(p, w);
+                barreira.esperar();
+            }
+        };
 
-// Função de hash personalizada para std::pair<string, string>
-struct hash_pair {
-    template <typename T1, typename T2>
-    size_t operator() (const std::pair<T1, T2>& p) const {
-        auto h1 = std::hash<T1>{}(p.first);
-        auto h2 = std::hash<T2>{}(p.second);
-        return h1 ^ h2;  // Combina os hashes dos dois elementos da pair
+        vector<thread> threads;
+        for (int w = 1; w < W; ++w) threads.emplace_back(trabalhador, w);
+        trabalhador(0);
+        for (auto& t : threads) t.join();
+        for (size_t e : eventos) m_numEventos += e;
     }
+
+private:
+    vector<Agente> m_agentes;
+    vector<vertex> m_cruzamento;   // Passos de todos os agentes, concatenados
+    vector<float> m_duracao;       // Tempo da rua que chega em cada passo
+    vector<int32_t> m_regiao;      // Região de cada cruzamento
+    int32_t m_numRegioes = 0;
+    size_t m_numEventos = 0;
 };
 
-// Declaração antecipada da classe Pessoa
-class Cidade;
+// Ruas do Graph em CSR para a simulação: só leitura depois de montada, então é compartilhada
+// por todos os trabalhadores. Só entram as arestas do tipo de transporte dos agentes (caminhada,
+// por padrão), e arestas repetidas entre os mesmos cruzamentos viram uma só, com o menor tempo.
+// O tempo de cada rua é time_cost / 10 segundos.
+class MalhaSimulacao {
+public:
+    MalhaSimulacao() : m_inicio(1, 0) {}
+
+    explicit MalhaSimulacao(const Graph& graph, const string& transporte = "walk") {
+        int numVertices = graph.getNumVertices();
+        m_inicio.assign(numVertices + 1, 0);
+        vector<pair<vertex, float>> vizinhos;
+        for (vertex v = 0; v < numVertices; ++v) {
+            vizinhos.clear();
+            for (Edge* edge = graph.getEdges(v); edge; edge = edge->next()) {
+                if (edge->transport_type() != transporte) continue;
+                vizinhos.push_back({edge->v2(), (float)(edge->time_cost() / 10)});
+            }
+            sort(vizinhos.begin(), vizinhos.end());
+            for (size_t i = 0; i < vizinhos.size(); ++i) {
+                if (i > 0 && vizinhos[i].first == vizinhos[i - 1].first) continue;  // Já tem o menor tempo
+                m_destino.push_back(vizinhos[i].first);
+                m_tempo.push_back(vizinhos[i].second);
+            }
+            m_inicio[v + 1] = m_destino.size();
+        }
+    }
+
+    int getNumVertices() const { return m_inicio.size() - 1; }
+    int32_t inicio(vertex v) const { return m_inicio[v]; }
+    int32_t fim(vertex v) const { return m_inicio[v + 1]; }
+    vertex destino(int32_t rua) const { return m_destino[rua]; }
+    float tempo(int32_t rua) const { return m_tempo[rua]; }
+
+    // Tempo da rua de v para w (-1 se não houver)
+    float tempoRua(vertex v, vertex w) const {
+        for (int32_t rua = m_inicio[v]; rua < m_inicio[v + 1]; ++rua) {
+            if (m_destino[rua] == w) return m_tempo[rua];
+        }
+        return -1;
+    }
+
+private:
+    vector<int32_t> m_inicio;
+    vector<vertex> m_destino;
+    vector<float> m_tempo;
+};
 
 class Pessoa {
 public:
     string nome;
-    string cruzamento_atual;
-    string destino;
-    vector<string> caminho;
+    vertex cruzamento_atual;
+    vertex destino;
+    vector<vertex> caminho;
     double tempo_total;
 
     // Construtor
-    Pessoa(string nome, const vector<string>& caminho)
+    Pessoa(string nome, const vector<vertex>& caminho)
         : nome(nome), caminho(caminho), tempo_total(0) {
         cruzamento_atual = caminho[0]; // A pessoa começa no primeiro cruzamento
+        destino = caminho.back();
     }
 
-    void mover(Cidade& cidade);  // Declaração antecipada da função mover
-
-    void exibir_status() {
+    void exibir_status(const Graph& graph) {
         cout << "Pessoa: " << nome << endl;
-        cout << "Cruzamento Atual: " << cruzamento_atual << endl;
+        cout << "Cruzamento Atual: " << graph.getNodeId(cruzamento_atual) << endl;
         cout << "Tempo Total: " << tempo_total << " segundos" << endl;
         cout << "Caminho percorrido: ";
-        for (auto& p : caminho) {
-            cout << p << " ";
+        for (vertex p : caminho) {
+            cout << graph.getNodeId(p) << " ";
         }
-        cout << endl; 
+        cout << endl;
     }
 };
 
-// Classe Cidade
+// Classe Cidade: o mesmo Graph usado pelo planejador de rotas, mais a malha de simulação
 class Cidade {
 public:
-    unordered_map<string, vector<pair<string, double>>> grafo;  // Mapeia cada cruzamento para os vizinhos e tempo
+    vector<int32_t> regiao_cruzamento;  // Região de cada cruzamento, numerada a partir de 0
 
     // Carrega o grafo a partir de um arquivo JSON
     bool carregar_grafo_de_json(const string& arquivo_json) {
-        Graph graph;
-        if (!graph.loadFromJson(arquivo_json)) {
-            return false; // Se não conseguir carregar o grafo, retorna false
-        }
-
-        // Preenche o grafo da cidade com os dados do grafo carregado
-        for (const auto& node : graph.getNodes()) {
-            // Adiciona as arestas de cada nó
-            for (const auto& edge : graph.getEdges()) {
-                if (edge.from == node.id) {
-                    // Adiciona a aresta com o tempo de deslocamento (time_cost)
-                    grafo[edge.from].push_back({edge.to, edge.time_cost/10});
-                }
+        // Conta os nós antes de criar o Graph, como em main.cpp
+        ifstream file(arquivo_json);
+        if (!file.is_open()) {
+            return false;
+        }
+        json dados = json::parse(file, nullptr, false);
+        if (dados.is_discarded() || !dados.contains("nodes")) {
+            return false;
+        }
+        m_graph.reset(new Graph(dados["nodes"].size()));
+        if (!m_graph->loadFromJSON(arquivo_json)) {
+            return false;
+        }
+        m_malha = MalhaSimulacao(*m_graph);
+
+        // Regiões do JSON numeradas densamente para indexar as partições
+        unordered_map<int, int32_t> indice_regiao;
+        regiao_cruzamento.assign(m_graph->getNumVertices(), 0);
+        for (vertex v = 0; v < m_graph->getNumVertices(); ++v) {
+            int regiao = m_graph->getRegion(m_graph->getNodeId(v));
+            if (!indice_regiao.count(regiao)) {
+                int32_t proxima = indice_regiao.size();
+                indice_regiao[regiao] = proxima;
             }
+            regiao_cruzamento[v] = indice_regiao[regiao];
         }
-
         return true;
     }
 
-    // Função auxiliar para criar um caminho aleatório
-    vector<string> gerar_caminho_aleatorio(int n) {
-        vector<string> caminho;
-        vector<string> nodes;
-        // Preenche o vetor com todos os nós do grafo
-        for (const auto& pair : grafo) {
-            nodes.push_back(pair.first);
-        }
+    const Graph& grafo() const { return *m_graph; }
+    const MalhaSimulacao& malha() const { return m_malha; }
 
-        // Gerando um caminho aleatório
-        random_device rd;
-        mt19937 gen(rd());
-        uniform_int_distribution<> dis(0, nodes.size() - 1);
+    // Função auxiliar para criar um caminho aleatório (para antes se chegar num cruzamento sem saída)
+    vector<vertex> gerar_caminho_aleatorio(int n) {
+        vector<vertex> caminho;
+        uniform_int_distribution<> dis(0, m_malha.getNumVertices() - 1);
 
-        string node_atual = nodes[dis(gen)]; // Pega um nó aleatório para começar
+        vertex node_atual = dis(m_gerador); // Pega um nó aleatório para começar
         caminho.push_back(node_atual);
 
         for (int i = 0; i < n - 1; ++i) {
             // Seleciona um vizinho aleatório para o próximo nó
-            auto& vizinhos = grafo[node_atual];
-            uniform_int_distribution<> dis_vizinho(0, vizinhos.size() - 1);
-            int vizinho_index = dis_vizinho(gen);
-            node_atual = vizinhos[vizinho_index].first;  // O próximo cruzamento
+            int32_t inicio = m_malha.inicio(node_atual);
+            int32_t fim = m_malha.fim(node_atual);
+            if (inicio == fim) break;
+            uniform_int_distribution<> dis_vizinho(inicio, fim - 1);
+            node_atual = m_malha.destino(dis_vizinho(m_gerador));  // O próximo cruzamento
             caminho.push_back(node_atual);
         }
 
@@ -110,64 +437,181 @@ public:
     // Função para exibir o caminho aleatório gerado
     void exibir_caminho_aleatorio(const Pessoa& pessoa) {
         cout << "Caminho aleatorio gerado para " << pessoa.nome << ": ";
-        for (const auto& cruzamento : pessoa.caminho) {
-            cout << cruzamento << " ";
+        for (vertex cruzamento : pessoa.caminho) {
+            cout << m_graph->getNodeId(cruzamento) << " ";
         }
         cout << endl;
     }
 
     // Atualiza a posição de uma pessoa e imprime o evento
-    void atualizar_posicao_pessoa(const string& nome_pessoa, const string& cruzamento, double tempo_decorrido) {
-        cout << nome_pessoa << " - " << cruzamento << " - " << tempo_decorrido << endl;
+    void atualizar_posicao_pessoa(const string& nome_pessoa, vertex cruzamento, double tempo_decorrido) {
+        cout << nome_pessoa << " - " << m_graph->getNodeId(cruzamento) << " - " << tempo_decorrido << endl;
     }
 
-    // Simula o movimento de todas as pessoas
-    void simular_pessoas(vector<Pessoa>& pessoas) {
-        vector<future<void>> futures;
-
-        // Cria uma thread para cada pessoa
-        for (int i = 0; i < pessoas.size(); ++i) {
-            futures.push_back(std::async(launch::async, &Pessoa::mover, &pessoas[i], ref(*this)));
+    // Adiciona o caminho ao simulador com o tempo de cada rua tirado da malha
+    int adicionar_ao_simulador(Simulador& simulador, const vector<vertex>& caminho, double partida) {
+        vector<float> duracoes(caminho.size(), 0);
+        for (size_t i = 1; i < caminho.size(); ++i) {
+            float tempo_rua = m_malha.tempoRua(caminho[i - 1], caminho[i]);
+            if (tempo_rua < 0) {
+                cerr << "Nao ha rua entre " << m_graph->getNodeId(caminho[i - 1]) << " e " << m_graph->getNodeId(caminho[i]) << endl;
+                return -1;
+            }
+            duracoes[i] = tempo_rua;
         }
+        return simulador.adicionar_agente(caminho, duracoes, partida);
+    }
 
-        // Espera todas as threads terminarem
-        for (auto& fut : futures) {
-            fut.get();  // Espera todas as threads terminarem
+    // Simula o movimento de todas as pessoas, saindo juntas no tempo 0
+    void simular_pessoas(vector<Pessoa>& pessoas, double fatorTempo = 0) {
+        Simulador simulador;
+        // Pessoa de cada agente: quem tem caminho inválido não vira agente, então os índices
+        // dos agentes não acompanham os das pessoas
+        vector<size_t> pessoaDoAgente;
+        for (size_t i = 0; i < pessoas.size(); ++i) {
+            int agente = adicionar_ao_simulador(simulador, pessoas[i].caminho, 0);
+            if (agente == -1) {
+                cerr << pessoas[i].nome << " nao sera simulado" << endl;
+                continue;
+            }
+            if ((size_t)agente >= pessoaDoAgente.size()) pessoaDoAgente.resize(agente + 1);
+            pessoaDoAgente[agente] = i;
         }
-    }
-};
 
-// Definindo a função mover
-void Pessoa::mover(Cidade& cidade) {
-    // A pessoa se move seguindo o caminho que ela tem
-    for (size_t i = 0; i < caminho.size() - 1; ++i) {
-        string cruzamento_atual = caminho[i];
-        string proximo_cruzamento = caminho[i + 1];
+        simulador.executar(fatorTempo, [&](int agente, vertex cruzamento, double tempo, bool terminou) {
+            Pessoa& pessoa = pessoas[pessoaDoAgente[agente]];
+            pessoa.cruzamento_atual = cruzamento;
+            pessoa.tempo_total = tempo;
+            if (tempo > 0) atualizar_posicao_pessoa(pessoa.nome, cruzamento, tempo);
+            if (terminou) pessoa.exibir_status(*m_graph);  // A pessoa chegou ao destino
+        });
+    }
 
-        // Encontrando o tempo para percorrer essa rua usando time_cost
-        double tempo_rua = 0;
-        for (auto& vizinho : cidade.grafo[cruzamento_atual]) {
-            if (vizinho.first == proximo_cruzamento) {
-                tempo_rua = vizinho.second;
-                break;
+    // Simula numViagens viagens aleatórias de `passos` cruzamentos com partidas distribuídas ao
+    // longo do dia. Só contadores são mantidos; imprimir cada evento é opcional. Com mais de um
+    // trabalhador, a simulação é particionada pelas regiões (cada uma em `subdivisoes` partes).
+    // Com arquivoLog, cada chegada vai para o log binário (ver eventLog.h) em vez do cout.
+    void simular_dia(int numViagens, int passos, double fatorTempo, bool imprimirEventos,
+                     int numTrabalhadores = 1, int subdivisoes = 1, const string& arquivoLog = "") {
+        const double SEGUNDOS_DIA = 86400.0;
+        Simulador simulador;
+        simulador.definir_regioes(regiao_cruzamento);
+        uniform_real_distribution<> disPartida(0, SEGUNDOS_DIA);
+
+        auto inicio = chrono::steady_clock::now();
+        for (int i = 0; i < numViagens; ++i) {
+            adicionar_ao_simulador(simulador, gerar_caminho_aleatorio(passos), disPartida(m_gerador));
+        }
+        auto preparado = chrono::steady_clock::now();
+
+        // Contadores por trabalhador, cada um na sua linha de cache
+        struct alignas(64) Contadores {
+            int concluidas = 0;
+            double tempoTotal = 0;
+            double ultimoEvento = 0;
+        };
+        vector<Contadores> contadores(max(1, numTrabalhadores));
+        unique_ptr<EventLog> log;
+        if (!arquivoLog.empty()) {
+            log.reset(new EventLog(arquivoLog, max(1, numTrabalhadores)));
+            if (!log->aberto()) return;
+            vector<string> nomes(m_graph->getNumVertices());
+            for (vertex v = 0; v < m_graph->getNumVertices(); ++v) nomes[v] = m_graph->getNodeId(v);
+            log->definirNomes(nomes);
+        }
+        mutex mutexSaida;
+        auto aoChegar = [&](int trabalhador, int agente, vertex cruzamento, double tempo, bool terminou) {
+            Contadores& c = contadores[trabalhador];
+            if (log) {
+                log->registrar(trabalhador, agente, cruzamento, tempo);
+            } else if (imprimirEventos) {
+                lock_guard<mutex> lock(mutexSaida);
+                atualizar_posicao_pessoa(to_string(agente), cruzamento, tempo);
             }
+            if (terminou) {
+                ++c.concluidas;
+                c.tempoTotal += tempo - simulador.getAgente(agente).partida;
+            }
+            c.ultimoEvento = max(c.ultimoEvento, tempo);
+        };
+        if (numTrabalhadores > 1) {
+            simulador.executar_paralelo(numTrabalhadores, subdivisoes, fatorTempo, aoChegar);
+        } else {
+            simulador.executar(fatorTempo, [&](int agente, vertex cruzamento, double tempo, bool terminou) {
+                aoChegar(0, agente, cruzamento, tempo, terminou);
+            });
+        }
+        auto fim = chrono::steady_clock::now();
+        if (log) log->fechar();
+
+        int concluidas = 0;
+        double tempoTotal = 0;
+        double ultimoEvento = 0;
+        for (const Contadores& c : contadores) {
+            concluidas += c.concluidas;
+            tempoTotal += c.tempoTotal;
+            ultimoEvento = max(ultimoEvento, c.ultimoEvento);
         }
 
-        // Simulando o tempo de deslocamento
-        std::this_thread::sleep_for(std::chrono::seconds((int)tempo_rua));  // Pausa apenas essa thread
-        
-        // Atualizando o tempo total e o cruzamento atual após o tempo de movimento
-        tempo_total += tempo_rua;
-
-        // Notificando a cidade sobre a chegada da pessoa no novo cruzamento
-        cidade.atualizar_posicao_pessoa(nome, proximo_cruzamento, tempo_total);
+        double segundosPreparo = chrono::duration<double>(preparado - inicio).count();
+        double segundosSimulacao = chrono::duration<double>(fim - preparado).count();
+        cout << "Viagens simuladas: " << concluidas << endl;
+        cout << "Eventos processados: " << simulador.getNumEventos() << endl;
+        cout << "Tempo medio de viagem: " << (concluidas ? tempoTotal / concluidas : 0) << " segundos" << endl;
+        cout << "Ultimo evento no tempo simulado: " << ultimoEvento << " segundos" << endl;
+        cout << "Geracao dos caminhos: " << segundosPreparo << " s" << endl;
+        cout << "Simulacao: " << segundosSimulacao << " s ("
+             << (segundosSimulacao > 0 ? simulador.getNumEventos() / segundosSimulacao : 0) << " eventos/s)" << endl;
+        if (log) cout << "Eventos gravados em " << arquivoLog << ": " << log->getNumEventos() << endl;
     }
 
-    // Após percorrer todo o caminho, a pessoa chega ao destino
-    exibir_status();
-}
+    void semear(unsigned semente) { m_gerador.seed(semente); }
+
+private:
+    unique_ptr<Graph> m_graph;
+    MalhaSimulacao m_malha;
+    mt19937 m_gerador{random_device{}()};
+};
+
+// Compilação: g++ -std=c++17 -O3 -pthread base_API.cpp Graph.cpp eventLog.cpp -o base_API
+// Uso: base_API [--viagens N] [--passos n] [--velocidade F] [--eventos] [--threads T]
+//               [--subdivisoes S] [--semente X] [--log eventos.bin]
+// Sem --viagens, simula as duas pessoas de exemplo. --velocidade é o fator sobre o tempo real
+// (1 = tempo real, 0 = o mais rápido possível, padrão). --threads usa a execução particionada
+// por região (padrão: número de núcleos), com cada região dividida em S partições. --log grava
+// as chegadas no log binário, lido com eventLogReader.
+int main(int argc, char* argv[]) {
+    int numViagens = 0;
+    int passos = 10;
+    double fatorTempo = 0;
+    bool imprimirEventos = false;
+    int numTrabalhadores = max(1u, thread::hardware_concurrency());
+    int subdivisoes = 2;
+    long semente = -1;
+    string arquivoLog;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--viagens") == 0 && i + 1 < argc) {
+            numViagens = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--passos") == 0 && i + 1 < argc) {
+            passos = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--velocidade") == 0 && i + 1 < argc) {
+            fatorTempo = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--eventos") == 0) {
+            imprimirEventos = true;
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            numTrabalhadores = max(1, atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--subdivisoes") == 0 && i + 1 < argc) {
+            subdivisoes = max(1, atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--semente") == 0 && i + 1 < argc) {
+            semente = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--log") == 0 && i + 1 < argc) {
+            arquivoLog = argv[++i];
+        } else {
+            cerr << "Argumento desconhecido: " << argv[i] << endl;
+            return 1;
+        }
+    }
 
-int main() {
     Cidade cidade;
 
     // Carrega o grafo do arquivo JSON
@@ -175,6 +619,12 @@ int main() {
         cerr << "Erro ao carregar o grafo do arquivo JSON!" << endl;
         return 1;
     }
+    if (semente >= 0) cidade.semear(semente);
+
+    if (numViagens > 0) {
+        cidade.simular_dia(numViagens, passos, fatorTempo, imprimirEventos, numTrabalhadores, subdivisoes, arquivoLog);
+        return 0;
+    }
 
     // Criando pessoas e atribuindo caminhos aleatórios
     Pessoa pessoa1("Fulano", cidade.gerar_caminho_aleatorio(5));  // Caminho aleatório de tamanho 5
@@ -186,7 +636,7 @@ int main() {
 
     // Simulando a movimentação das pessoas
     vector<Pessoa> pessoas = {pessoa1, pessoa2};
-    cidade.simular_pessoas(pessoas);
+    cidade.simular_pessoas(pessoas, fatorTempo);
 
-    return 0; 
-}
\ No newline at end of file
+    return 0;
+}
@@ -0,0 +1,205 @@
+#include "batchRoutes.h"
+#include "fastRoute.h"
+#include "routeCache.h"
+#include "stateGraph.h"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include <algorithm>
+
+namespace {
+
+// Consultas são lidas e processadas em blocos para não manter o arquivo inteiro em memória
+const size_t TAMANHO_BLOCO = 1 << 16;
+
+vertex lerVertice(const json& valor, const Graph& graph) {
+    if (valor.is_string()) {
+        return graph.getVertex(valor.get<std::string>());
+    }
+    if (valor.is_number_integer()) {
+        int v = valor.get<int>();
+        return (v >= 0 && v < graph.getNumVertices()) ? v : -1;
+    }
+    return -1;
+}
+
+json caminhoComIds(const Graph& graph, const std::vector<vertex>& caminho) {
+    json ids = json::array();
+    for (vertex v : caminho) {
+        ids.push_back(graph.getNodeId(v));
+    }
+    return ids;
+}
+
+std::string escreverResultado(const Graph& graph, const std::string& linha, const ConsultaRota& consulta,
+                              const std::pair<std::vector<vertex>, double>& resultado,
+                              const std::vector<RotaPareto>& fronteira, double latenciaUs) {
+    json saida;
+    if (!consulta.erro.empty()) {
+        saida["input"] = linha;
+        saida["error"] = consulta.erro;
+        return saida.dump();
+    }
+
+    saida["origin"] = graph.getNodeId(consulta.origem);
+    saida["destination"] = graph.getNodeId(consulta.destino);
+    saida["budget"] = consulta.orcamento;
+    saida["found"] = !resultado.first.empty();
+    if (!resultado.first.empty()) {
+        saida["time"] = resultado.second;
+        saida["path"] = caminhoComIds(graph, resultado.first);
+    }
+    if (consulta.fronteira) {
+        saida["frontier"] = json::array();
+        for (const RotaPareto& rota : fronteira) {
+            saida["frontier"].push_back({{"time", rota.tempo}, {"cost", rota.dinheiro}, {"path", caminhoComIds(graph, rota.caminho)}});
+        }
+    }
+    saida["latency_us"] = latenciaUs;
+    return saida.dump();
+}
+
+} // namespace
+
+ConsultaRota lerConsultaRota(const std::string& linha, const Graph& graph) {
+    ConsultaRota consulta{-1, -1, 0, TODOS_OS_MODOS, false, ""};
+    json dado = json::parse(linha, nullptr, false);
+    if (dado.is_discarded() || !dado.is_object()) {
+        consulta.erro = "invalid json";
+        return consulta;
+    }
+    if (!dado.contains("origin") || !dado.contains("destination") || !dado.contains("budget") || !dado["budget"].is_number()) {
+        consulta.erro = "expected origin, destination and budget";
+        return consulta;
+    }
+
+    consulta.origem = lerVertice(dado["origin"], graph);
+    consulta.destino = lerVertice(dado["destination"], graph);
+    consulta.orcamento = dado["budget"].get<double>();
+    if (consulta.origem == -1 || consulta.destino == -1) {
+        consulta.erro = "unknown node id";
+        return consulta;
+    }
+    if (!std::isfinite(consulta.orcamento) || consulta.orcamento < 0) {
+        consulta.erro = "budget must be a finite non-negative number";
+        return consulta;
+    }
+
+    if (dado.contains("frontier")) {
+        if (!dado["frontier"].is_boolean()) {
+            consulta.erro = "frontier must be a boolean";
+            return consulta;
+        }
+        consulta.fronteira = dado["frontier"].get<bool>();
+    }
+
+    if (dado.contains("modes")) {
+        if (!dado["modes"].is_array()) {
+            consulta.erro = "modes must be an array";
+            return consulta;
+        }
+        consulta.mascaraModos = 0;
+        for (const auto& modo : dado["modes"]) {
+            ModoTransporte m = modo.is_string() ? modoDaAresta(modo.get<std::string>()) : MODO_DESCONHECIDO;
+            if (m == MODO_DESCONHECIDO) {
+                consulta.erro = "unknown mode";
+                return consulta;
+            }
+            consulta.mascaraModos |= (1 << m);
+        }
+    }
+    return consulta;
+}
+
+ResumoLote executarConsultasEmLote(Graph& graph, const std::string& arquivoEntrada, const std::string& arquivoSaida,
+                                   int numThreads, RouteCache* cache) {
+    ResumoLote resumo;
+
+    std::ifstream entrada(arquivoEntrada);
+    if (!entrada.is_open()) {
+        std::cerr << "Falha ao abrir " << arquivoEntrada << std::endl;
+        return resumo;
+    }
+    std::ofstream saida(arquivoSaida);
+    if (!saida.is_open()) {
+        std::cerr << "Falha ao abrir o arquivo para escrita." << std::endl;
+        return resumo;
+    }
+
+    if (numThreads <= 0) {
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    auto inicio = std::chrono::steady_clock::now();
+
+    // Compila o grafo de estados uma vez antes de iniciar as threads; todas as buscas o compartilham
+    std::shared_ptr<const StateGraph> estados = StateGraph::compilado(graph);
+
+    std::vector<std::string> linhas;
+    std::vector<std::string> resultados;
+    std::atomic<long long> encontradas(0);
+    std::atomic<long long> invalidas(0);
+
+    std::string linha;
+    while (true) {
+        // Lê o próximo bloco (linhas vazias são ignoradas)
+        linhas.clear();
+        while (linhas.size() < TAMANHO_BLOCO && std::getline(entrada, linha)) {
+            if (!linha.empty() && linha.back() == '\r') linha.pop_back();
+            if (!linha.empty()) linhas.push_back(linha);
+        }
+        if (linhas.empty()) break;
+
+        resultados.assign(linhas.size(), std::string());
+
+        // As threads pegam a próxima consulta livre de um contador atômico; o grafo é só lido
+        std::atomic<size_t> proxima(0);
+        auto trabalhador = [&]() {
+            size_t i;
+            while ((i = proxima.fetch_add(1)) < linhas.size()) {
+                ConsultaRota consulta = lerConsultaRota(linhas[i], graph);
+                std::pair<std::vector<vertex>, double> resultado;
+                std::vector<RotaPareto> fronteira;
+                auto t0 = std::chrono::steady_clock::now();
+                if (consulta.erro.empty() && consulta.fronteira) {
+                    // A fronteira inteira já contém a melhor rota do orçamento: uma busca só, sem cache
+                    fronteira = fronteira_tempo_custo(graph, consulta.origem, consulta.destino, consulta.orcamento, consulta.mascaraModos);
+                    resultado = melhor_da_fronteira(fronteira, consulta.orcamento);
+                    if (!resultado.first.empty()) encontradas++;
+                } else if (consulta.erro.empty()) {
+                    resultado = cache
+                        ? cache->consultar(graph, consulta.origem, consulta.destino, consulta.orcamento, consulta.mascaraModos)
+                        : obter_melhor_trajeto(graph, consulta.origem, consulta.destino, consulta.orcamento, consulta.mascaraModos);
+                    if (!resultado.first.empty()) encontradas++;
+                } else {
+                    invalidas++;
+                }
+                double latenciaUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+                resultados[i] = escreverResultado(graph, linhas[i], consulta, resultado, fronteira, latenciaUs);
+            }
+        };
+
+        std::vector<std::thread> threads;
+        int usadas = std::min<size_t>(numThreads, linhas.size());
+        for (int t = 1; t < usadas; ++t) {
+            threads.emplace_back(trabalhador);
+        }
+        trabalhador();  // A thread principal também trabalha
+        for (auto& th : threads) {
+            th.join();
+        }
+
+        for (const std::string& r : resultados) {
+            saida << r << '\n';
+        }
+        resumo.consultas += linhas.size();
+    }
+
+    resumo.encontradas = encontradas;
+    resumo.invalidas = invalidas;
+    resumo.segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    return resumo;
+}
@@ -0,0 +1,42 @@
+#ifndef BATCHROUTES_H
+#define BATCHROUTES_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "graph.h"
+
+class RouteCache;
+
+// Consulta de rota lida do arquivo JSONL: {"origin": "node_1_2", "destination": "node_5_7", "budget": 12}
+// (origem e destino também podem ser índices de vértice). O campo opcional "modes", ex.
+// ["walk", "metro"], restringe os modos de transporte usados; sem ele todos são permitidos.
+// Com "frontier": true o resultado traz também a fronteira de Pareto tempo x custo até o orçamento.
+struct ConsultaRota {
+    vertex origem;
+    vertex destino;
+    double orcamento;
+    uint8_t mascaraModos;
+    bool fronteira;
+    std::string erro;  // Preenchido se a linha for inválida
+};
+
+// Resumo da execução em lote
+struct ResumoLote {
+    long long consultas = 0;
+    long long encontradas = 0;
+    long long invalidas = 0;
+    double segundos = 0;
+};
+
+// Converte uma linha JSONL em consulta (campo erro preenchido se a linha for inválida)
+ConsultaRota lerConsultaRota(const std::string& linha, const Graph& graph);
+
+// Executa as consultas do arquivo JSONL de entrada em paralelo sobre o grafo (somente leitura)
+// e grava um resultado JSONL por consulta, na mesma ordem da entrada, com a latência de cada uma.
+// numThreads <= 0 usa o número de núcleos da máquina. Com cache, consultas repetidas
+// (mesmo par, orçamento e modos) são respondidas sem nova busca.
+ResumoLote executarConsultasEmLote(Graph& graph, const std::string& arquivoEntrada, const std::string& arquivoSaida,
+                                   int numThreads = 0, RouteCache* cache = nullptr);
+
+#endif // BATCHROUTES_H
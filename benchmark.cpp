@@ -0,0 +1,238 @@
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "external/json.hpp"
+#include "aleatorio.h"
+#include "graph.h"
+#include "dataStructures.h"
+#include "newMetro.h"
+#include "bus.h"
+#include "bus3.h"
+#include "fastRoute.h"
+#include "ssspCache.h"
+#include "cityGenerator.h"
+#include "memoryReport.h"
+#include "stats.h"
+
+// Benchmark dos núcleos de grafo em cidades de vários tamanhos geradas por cityGenerator.h (o
+// modelo de main.py). Saída em JSON.
+// Compilação: g++ -std=c++17 -O3 benchmark.cpp cityGenerator.cpp Graph.cpp dataStructures.cpp newMetro.cpp bus.cpp
+//             bus3.cpp fastestRouteQ3.cpp busTour.cpp ssspCache.cpp stateGraph.cpp travelProfiles.cpp stats.cpp
+//             memoryReport.cpp -o benchmark
+// Uso: benchmark [--grades 24x16,100x100,...] [--repeticoes R] [--max-quadratico V] [--semente S] [--pular P]
+//                [--saida arquivo.json]
+// Os núcleos quadráticos no número de vértices (Heap, escavacaoMetro, calcularMatrizDeDistancias)
+// só rodam em grades de até --max-quadratico vértices.
+
+using json = nlohmann::json;
+
+namespace {
+
+// Resultado de uma execução do núcleo: tamanho da saída (vértices alcançados, arestas da MST...),
+// descrito por `unidade` no relatório. O trabalho das buscas vem dos contadores de stats.h.
+typedef std::function<long long()> Nucleo;
+
+// `preparar` roda antes de cada repetição, fora do tempo medido (ex. descartar caches do grafo)
+json medir(const std::string& nome, const std::string& unidade, int repeticoes, const Nucleo& nucleo,
+           const std::function<void()>& preparar = nullptr) {
+    std::vector<double> tempos;
+    long long saida = 0;
+    ContadoresBusca busca;  // Buscas da última repetição
+    long picoAntes = picoRssKb();
+    for (int r = 0; r < repeticoes; ++r) {
+        SsspCache::compartilhado().limpar();  // Cada repetição começa sem árvores guardadas
+        if (preparar) preparar();
+        ContadoresBusca antes = Estatisticas::global().totalBuscas();
+        auto inicio = std::chrono::steady_clock::now();
+        saida = nucleo();
+        tempos.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - inicio).count());
+        ContadoresBusca depois = Estatisticas::global().totalBuscas();
+        busca.buscas = depois.buscas - antes.buscas;
+        busca.assentados = depois.assentados - antes.assentados;
+        busca.relaxadas = depois.relaxadas - antes.relaxadas;
+    }
+    std::sort(tempos.begin(), tempos.end());
+    json resultado;
+    resultado["kernel"] = nome;
+    resultado["min_ms"] = tempos.front();
+    resultado["median_ms"] = tempos[tempos.size() / 2];
+    resultado["output"] = saida;
+    resultado["output_unit"] = unidade;
+#ifndef PAA_SEM_ESTATISTICAS
+    resultado["searches"] = busca.buscas;
+    resultado["settled"] = busca.assentados;
+    resultado["relaxed"] = busca.relaxadas;
+#else
+    resultado["searches"] = nullptr;  // Contadores desligados na compilação
+    resultado["settled"] = nullptr;
+    resultado["relaxed"] = nullptr;
+#endif
+    // O pico de memória do processo só cresce: o que vale por núcleo é quanto ele subiu
+    resultado["peak_rss_growth_kb"] = picoRssKb() - picoAntes;
+    return resultado;
+}
+
+json ignorado(const std::string& nome, const std::string& motivo) {
+    json resultado;
+    resultado["kernel"] = nome;
+    resultado["skipped"] = motivo;
+    return resultado;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::vector<std::pair<int, int>> grades = {{24, 16}, {50, 50}, {100, 100}, {200, 200}, {500, 500}, {1000, 1000}};
+    int repeticoes = 3;
+    int maxQuadratico = 5000;
+    ParametrosCidade parametros;
+    std::string arquivoSaida;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--grades") == 0 && i + 1 < argc) {
+            grades.clear();
+            std::string lista = argv[++i];
+            size_t inicio = 0;
+            while (inicio < lista.size()) {
+                size_t fim = lista.find(',', inicio);
+                if (fim == std::string::npos) fim = lista.size();
+                int linhas, colunas;
+                if (std::sscanf(lista.substr(inicio, fim - inicio).c_str(), "%dx%d", &linhas, &colunas) != 2 || linhas <= 0 || colunas <= 0) {
+                    std::cerr << "Grade invalida: " << lista.substr(inicio, fim - inicio) << std::endl;
+                    return 1;
+                }
+                grades.push_back({linhas, colunas});
+                inicio = fim + 1;
+            }
+        } else if (std::strcmp(argv[i], "--repeticoes") == 0 && i + 1 < argc) {
+            repeticoes = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--max-quadratico") == 0 && i + 1 < argc) {
+            maxQuadratico = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--semente") == 0 && i + 1 < argc) {
+            parametros.semente = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--pular") == 0 && i + 1 < argc) {
+            parametros.probabilidadePular = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--saida") == 0 && i + 1 < argc) {
+            arquivoSaida = argv[++i];
+        } else {
+            std::cerr << "Uso: " << argv[0] << " [--grades 24x16,100x100] [--repeticoes R] [--max-quadratico V]"
+                      << " [--semente S] [--pular P] [--saida arquivo.json]" << std::endl;
+            return 1;
+        }
+    }
+
+    json relatorio;
+    relatorio["repetitions"] = repeticoes;
+    relatorio["seed"] = parametros.semente;
+    relatorio["skip_probability"] = parametros.probabilidadePular;
+    relatorio["grids"] = json::array();
+
+    for (auto [linhas, colunas] : grades) {
+        auto inicio = std::chrono::steady_clock::now();
+        parametros.linhas = linhas;
+        parametros.colunas = colunas;
+        std::unique_ptr<Graph> grade = CidadeGerada(parametros).construirGrafo();
+        Graph& graph = *grade;
+        double msConstrucao = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - inicio).count();
+        const int V = graph.getNumVertices();
+        std::cerr << "Grade " << linhas << "x" << colunas << " (" << V << " vertices)" << std::endl;
+
+        json resultado;
+        resultado["rows"] = linhas;
+        resultado["cols"] = colunas;
+        resultado["vertices"] = V;
+        resultado["edges"] = graph.getNumEdgeIds();
+        resultado["build_ms"] = msConstrucao;
+        resultado["graph_bytes"] = graph.memoria().total();
+        resultado["graph_estimated_bytes"] = estimarMemoriaGrafo(V, graph.getNumEdgeIds()).total();
+        json nucleos = json::array();
+        if (V < 2) {
+            resultado["kernels"] = nucleos;
+            resultado["peak_rss_kb"] = picoRssKb();
+            relatorio["grids"].push_back(resultado);
+            continue;
+        }
+
+        std::vector<vertex> parent(V);
+        std::vector<int> distancia(V);
+        nucleos.push_back(medir("cptDijkstraFast", "vertices", repeticoes, [&]() {
+            Dijkstra::cptDijkstraFast(0, parent.data(), distancia.data(), graph);
+            return (long long)std::count_if(distancia.begin(), distancia.end(), [](int d) { return d != INT_MAX; });
+        }));
+
+        nucleos.push_back(medir("mstKruskalFast", "mst edges", repeticoes, [&]() {
+            std::vector<Edge*> mst;
+            Kruskal::mstKruskalFast(mst, graph);
+            long long arestas = mst.size();
+            for (Edge* edge : mst) delete edge;
+            return arestas;
+        }));
+
+        // Heap::insert_or_update procura o vértice linearmente, então também é quadrático
+        if (V <= maxQuadratico) {
+            nucleos.push_back(medir("Heap", "heap operations", repeticoes, [&]() {
+                // V inserções, V/2 reduções de chave e V remoções, com chaves pseudoaleatórias
+                Heap heap;
+                long long operacoes = 0;
+                for (vertex v = 0; v < V; ++v, ++operacoes) heap.insert_or_update(misturar(v) % 1000000, v);
+                for (vertex v = 0; v < V; v += 2, ++operacoes) heap.insert_or_update(misturar(v) % 1000000 / 2, v);
+                while (!heap.empty()) {
+                    heap.pop();
+                    ++operacoes;
+                }
+                return operacoes;
+            }));
+            nucleos.push_back(medir("escavacaoMetro", "stations", repeticoes, [&]() {
+                auto resultadoMetro = escavacaoMetro(graph);
+                return (long long)std::get<2>(resultadoMetro).sources().size();
+            }));
+            nucleos.push_back(medir("calcularMatrizDeDistancias", "stops", repeticoes, [&]() {
+                std::vector<vertex> paradas;
+                calcularMatrizDeDistancias(graph, paradas);
+                return (long long)paradas.size();
+            }));
+        } else {
+            std::string motivo = "more than " + std::to_string(maxQuadratico) + " vertices";
+            nucleos.push_back(ignorado("Heap", motivo));
+            nucleos.push_back(ignorado("escavacaoMetro", motivo));
+            nucleos.push_back(ignorado("calcularMatrizDeDistancias", motivo));
+        }
+
+        // O grafo guarda os pesos de ônibus por coeficientes: pedi-los com outros coeficientes antes de
+        // cada repetição faz findHamiltonianCycle recalculá-los, como na primeira chamada
+        BusWeightCoefficients outrosCoeficientes;
+        outrosCoeficientes.commercial = 0;
+        nucleos.push_back(medir("findHamiltonianCycle", "cycle vertices", repeticoes, [&]() {
+            return (long long)findHamiltonianCycle(graph).size();
+        }, [&]() { graph.busWeights(outrosCoeficientes); }));
+
+        nucleos.push_back(medir("obter_melhor_trajeto", "route vertices", repeticoes, [&]() {
+            auto rota = obter_melhor_trajeto(graph, 0, V - 1, 12);
+            return (long long)rota.first.size();
+        }));
+
+        resultado["kernels"] = nucleos;
+        resultado["peak_rss_kb"] = picoRssKb();  // Pico do processo até o fim desta grade
+        relatorio["grids"].push_back(resultado);
+    }
+
+    if (arquivoSaida.empty()) {
+        std::cout << relatorio.dump(2) << std::endl;
+    } else {
+        std::ofstream saida(arquivoSaida);
+        if (!saida.is_open()) {
+            std::cerr << "Nao foi possivel abrir " << arquivoSaida << std::endl;
+            return 1;
+        }
+        saida << relatorio.dump(2) << std::endl;
+    }
+    return 0;
+}
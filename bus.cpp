@@ -3,6 +3,8 @@
 #include "Graph.h"
 #include "newMetro.h"
 #include "dataStructures.h"
+#include "busTour.h"
+#include "ssspCache.h"
 #include <unordered_set>
 #include <unordered_map>
 #include <climits>
@@ -26,6 +28,9 @@ std::vector<vertex> findHamiltonianCycle(Graph& graph) {
     cycle.push_back(start);
     visited[start] = true;
 
+    // Pesos de todas as arestas calculados de uma vez (ver Graph::busWeights)
+    const std::vector<double>& weights = graph.busWeights();
+
     vertex current = start;
     for (int i = 0; i < n - 1; ++i) {
         double minWeight = std::numeric_limits<double>::max();
@@ -35,7 +40,7 @@ std::vector<vertex> findHamiltonianCycle(Graph& graph) {
         while (edge) {
             vertex neighbor = edge->otherVertex(current);
             if (!visited[neighbor]) {
-                double weight = calculateEdgeWeight(*edge);
+                double weight = weights[edge->id()];
                 if (weight < minWeight) {
                     minWeight = weight;
                     next = neighbor;
@@ -73,34 +78,56 @@ void designBusRoute(Graph& graph) {
         outFile << "('" << node1 << "','" << node2 << "'),";
     }
 
-    int numVertices = graph.getNumVertices();
-
-    std::vector<int> distancia(numVertices, INT_MAX); 
-    std::vector<vertex> parent(numVertices, -1);
-
     vertex current = cycle[cycle.size() - 1];
     vertex v1 = cycle[0];
 
-    // Run Dijkstra algorithm
-    Dijkstra::cptDijkstraFast(v1, parent.data(), distancia.data(), graph);
+    // Árvore de Dijkstra a partir do início do ciclo (via cache compartilhado)
+    SptView<int> arvore = SsspCache::compartilhado().consultar(graph, v1);
 
-    while (current != v1 && current != -1) {
-        vertex p = parent[current];
-
-        Edge* originalEdge = graph.getEdges(p);
-        bool edgeFound = false;
-        while (originalEdge) {
-            if (originalEdge->otherVertex(p) == current) {
-                // Write the edge to the file
-                outFile << "('" << graph.getNodeId(p) << "','" << graph.getNodeId(current) << "'),";
-                break;
-            }
-            originalEdge = originalEdge->next();
-        }
-
-        current = p;
+    // Fecha o ciclo com o caminho mínimo de volta ao início, usando as arestas da árvore
+    std::vector<Edge*> caminho = Dijkstra::unpackPath(v1, current, arvore.parent, arvore.parentEdge, graph);
+    for (auto it = caminho.rbegin(); it != caminho.rend(); ++it) {
+        // Write the edge to the file
+        outFile << "('" << graph.getNodeId((*it)->v1()) << "','" << graph.getNodeId((*it)->v2()) << "'),";
     }
 
     outFile << "]" << std::endl;  // Close the edges array
     outFile.close();  // Close the file
-}
\ No newline at end of file
+}
+
+std::vector<vertex> designBusCycle(Graph& graph, const std::vector<vertex>& paradas, const std::vector<std::vector<int>>& matrizDistancias, double orcamentoMs, const std::string& arquivo) {
+    std::vector<vertex> cicloParadas;
+    if (paradas.empty()) return cicloParadas;
+
+    std::vector<int> ordem = otimizarCicloParadas(matrizDistancias, orcamentoMs);
+    for (int indice : ordem) {
+        cicloParadas.push_back(paradas[indice]);
+    }
+    std::cout << "Comprimento do ciclo de ônibus: " << comprimentoCiclo(ordem, matrizDistancias) << std::endl;
+
+    std::ofstream outFile(arquivo);
+    if (!outFile.is_open()) {
+        std::cerr << "Falha ao abrir o arquivo para escrita." << std::endl;
+        return cicloParadas;
+    }
+
+    // Expande cada trecho parada -> próxima parada nas ruas do caminho mínimo. As árvores das
+    // paradas normalmente já estão no cache, calculadas junto com a matriz de distâncias.
+    SsspCache& cache = SsspCache::compartilhado();
+
+    outFile << "[";
+    for (size_t i = 0; i < cicloParadas.size(); i++) {
+        vertex origem = cicloParadas[i];
+        vertex destino = cicloParadas[(i + 1) % cicloParadas.size()];
+        if (origem == destino) continue;
+
+        SptView<int> arvore = cache.consultar(graph, origem);
+        for (Edge* edge : Dijkstra::unpackPath(origem, destino, arvore.parent, arvore.parentEdge, graph)) {
+            outFile << "('" << graph.getNodeId(edge->v1()) << "','" << graph.getNodeId(edge->v2()) << "'),";
+        }
+    }
+    outFile << "]" << std::endl;
+    outFile.close();
+
+    return cicloParadas;
+}
@@ -10,6 +10,11 @@ double calculateEdgeWeight(const Edge&);
 std::vector<vertex> findHamiltonianCycle(Graph&);
 void designBusRoute(Graph&);
 
+// Ciclo de ônibus sobre as paradas escolhidas: otimiza a ordem com busca local na matriz de
+// distâncias (ver busTour.h), mostra o comprimento do ciclo, grava as ruas percorridas em arquivo
+// e retorna as paradas em ordem
+std::vector<vertex> designBusCycle(Graph& graph, const std::vector<vertex>& paradas, const std::vector<std::vector<int>>& matrizDistancias, double orcamentoMs = 200.0, const std::string& arquivo = "bus_cycle_edges.txt");
+
 // Define uma estrutura para Região
 struct Region {
     int number;
@@ -1,97 +1,97 @@
 #include "bus3.h"
 #include "Graph.h"
 #include "newMetro.h"
+#include "ssspCache.h"
 #include <limits.h>
 #include <vector>
 #include <iostream>
 #include <algorithm>
 
 // Função para calcular a distância entre dois vértices usando Dijkstra
+// (a árvore de cada origem é calculada uma vez e reaproveitada pelo cache compartilhado)
 int calcularDistancia(Graph& graph, vertex origem, vertex destino) {
-    std::vector<int> distancias(graph.getNumVertices(), INT_MAX);
-    std::vector<vertex> pais(graph.getNumVertices(), -1);
-    Dijkstra::cptDijkstraFast(origem, pais.data(), distancias.data(), graph);
-    return distancias[destino];
+    return SsspCache::compartilhado().distancia(graph, origem, destino);
 }
 
-// Função para encontrar os 3 melhores vértices com distância mínima de 800 entre eles
-std::vector<vertex> encontrarMelhoresVerticesParaRegiao(const std::vector<vertex>& regioes, Graph& graph) {
-    std::vector<vertex> melhoresVertices;
-
-    // Vetor para armazenar os 3 melhores vértices da região
-    std::vector<vertex> candidatos = regioes;
-
-    // Encontrar o melhor vértice (já implementado anteriormente)
-    vertex melhorVertice = -1;
-    int menorDistanciaMaxima = INT_MAX;
-
-    for (vertex v : candidatos) {
-        std::vector<int> distancias(graph.getNumVertices(), INT_MAX);
-        std::vector<vertex> pais(graph.getNumVertices(), -1);
-
-        // Executa Dijkstra a partir do vértice v
-        Dijkstra::cptDijkstraFast(v, pais.data(), distancias.data(), graph);
-
-        // Encontrar a maior distância para o vértice v
-        int distanciaMaxima = *std::max_element(distancias.begin(), distancias.end());
-
-        // Se a distância máxima for a menor que a anterior, atualiza o melhor vértice
-        if (distanciaMaxima < menorDistanciaMaxima) {
-            menorDistanciaMaxima = distanciaMaxima;
-            melhorVertice = v;
+// Centro aproximado da região por varredura dupla: o vértice da região mais distante de um vértice
+// qualquer é uma ponta de um caminho quase diametral, e a outra ponta é o vértice da região mais
+// distante dela. O centro é o vértice da região nesse caminho mais perto do meio. São duas
+// buscas por região, em vez de um Dijkstra por candidato.
+static vertex centroAproximado(const std::vector<vertex>& regiao, const std::vector<char>& naRegiao, Graph& graph) {
+    SsspCache& cache = SsspCache::compartilhado();
+    auto maisDistante = [&](const int* distancias, vertex origem) {
+        vertex resultado = origem;
+        for (vertex v : regiao) {
+            if (distancias[v] != INT_MAX && distancias[v] > distancias[resultado]) resultado = v;
         }
-    }
-
-    // Adiciona o melhor vértice à lista de melhores vértices
-    melhoresVertices.push_back(melhorVertice);
-
-    // Agora, tentamos adicionar o segundo melhor vértice, garantindo a distância mínima de 800 entre eles
-    vertex segundoMelhorVertice = -1;
-    for (vertex v : candidatos) {
-        if (v != melhorVertice) {
-            int distancia = calcularDistancia(graph, melhorVertice, v);
-            if (distancia >= 800) {
-                segundoMelhorVertice = v;
-                break;
-            }
+        return resultado;
+    };
+
+    vertex ponta = maisDistante(cache.consultar(graph, regiao[0]).distance, regiao[0]);
+    SptView<int> arvore = cache.consultar(graph, ponta);
+    vertex outraPonta = maisDistante(arvore.distance, ponta);
+
+    // Percorre o caminho outraPonta -> ponta e fica com o vértice da região de menor excentricidade estimada
+    int comprimento = arvore.distance[outraPonta];
+    vertex centro = ponta;
+    int menorExcentricidade = comprimento;
+    for (vertex v = outraPonta; v != ponta; v = arvore.parent[v]) {
+        int excentricidade = std::max(arvore.distance[v], comprimento - arvore.distance[v]);
+        if (naRegiao[v] && excentricidade < menorExcentricidade) {
+            menorExcentricidade = excentricidade;
+            centro = v;
         }
     }
+    return centro;
+}
 
-    if (segundoMelhorVertice != -1) {
-        melhoresVertices.push_back(segundoMelhorVertice);
-
-        // Tentamos adicionar o terceiro melhor vértice, garantindo que a distância entre ele e os anteriores seja >= 800
-        vertex terceiroMelhorVertice = -1;
-        for (vertex v : candidatos) {
-            if (v != melhorVertice && v != segundoMelhorVertice) {
-                int distanciaParaMelhor = calcularDistancia(graph, melhorVertice, v);
-                int distanciaParaSegundo = calcularDistancia(graph, segundoMelhorVertice, v);
-
-                if (distanciaParaMelhor >= 800 && distanciaParaSegundo >= 800) {
-                    terceiroMelhorVertice = v;
-                    break;
-                }
+// Seleciona até k paradas na região. A primeira é o centro aproximado da região; as seguintes são
+// escolhidas uma a uma como o vértice da região mais distante das paradas já escolhidas (k-centro
+// guloso), desde que essa distância seja de pelo menos distanciaMinima. A distância até o conjunto
+// de paradas é mantida em um vetor multi-fonte atualizado por uma busca limitada a cada nova parada.
+std::vector<vertex> selecionarParadasRegiao(const std::vector<vertex>& regiao, Graph& graph, int k, int distanciaMinima) {
+    std::vector<vertex> paradas;
+    if (regiao.empty() || k <= 0) return paradas;
+
+    std::vector<char> naRegiao(graph.getNumVertices(), 0);
+    for (vertex v : regiao) naRegiao[v] = 1;
+
+    // Distância de cada vértice até a parada mais próxima
+    std::vector<int> distanciaParadas(graph.getNumVertices(), INT_MAX);
+    vertex centro = centroAproximado(regiao, naRegiao, graph);
+    paradas.push_back(centro);
+    Dijkstra::updateMultiSource(centro, distanciaParadas.data(), graph);
+
+    while ((int)paradas.size() < k) {
+        // Próxima parada: o vértice da região mais distante das paradas atuais
+        vertex maisDistante = -1;
+        for (vertex v : regiao) {
+            if (distanciaParadas[v] != INT_MAX && (maisDistante == -1 || distanciaParadas[v] > distanciaParadas[maisDistante])) {
+                maisDistante = v;
             }
         }
 
-        if (terceiroMelhorVertice != -1) {
-            melhoresVertices.push_back(terceiroMelhorVertice);
+        if (maisDistante == -1 || distanciaParadas[maisDistante] < distanciaMinima) {
+            break;  // Nenhum vértice respeita a distância mínima
         }
+
+        paradas.push_back(maisDistante);
+        Dijkstra::updateMultiSource(maisDistante, distanciaParadas.data(), graph);
     }
 
-    return melhoresVertices;
+    return paradas;
 }
 
-// Função principal para iterar sobre as regiões e encontrar os 3 melhores vértices para cada região
-std::vector<std::vector<vertex>> encontrarMelhoresVerticesParaTodasRegioes(Graph& graph) {
+// Função principal para iterar sobre as regiões e encontrar as paradas de cada região
+std::vector<std::vector<vertex>> encontrarMelhoresVerticesParaTodasRegioes(Graph& graph, int paradasPorRegiao, int distanciaMinima) {
     // Obtemos as regiões do grafo
     std::vector<std::vector<vertex>> regioes = criarRegioes(graph);
 
     std::vector<std::vector<vertex>> melhoresVerticesPorRegiao;
     
-    // Para cada região, encontramos os 3 melhores vértices com a condição de distância >= 800 entre eles
+    // Para cada região, encontramos as paradas com a condição de distância >= distanciaMinima entre elas
     for (const auto& regioesDeVertice : regioes) {
-        std::vector<vertex> melhoresVertices = encontrarMelhoresVerticesParaRegiao(regioesDeVertice, graph);
+        std::vector<vertex> melhoresVertices = selecionarParadasRegiao(regioesDeVertice, graph, paradasPorRegiao, distanciaMinima);
         melhoresVerticesPorRegiao.push_back(melhoresVertices);
     }
 
@@ -99,24 +99,25 @@ std::vector<std::vector<vertex>> encontrarMelhoresVerticesParaTodasRegioes(Graph
 }
 
 // Função para criar a matriz de distâncias entre os vértices de parada de ônibus e coletar os vértices selecionados
-std::vector<std::vector<int>> calcularMatrizDeDistancias(Graph& graph, std::vector<vertex>& todosVertices) {
-    std::vector<std::vector<vertex>> melhoresVerticesPorRegiao = encontrarMelhoresVerticesParaTodasRegioes(graph);
+std::vector<std::vector<int>> calcularMatrizDeDistancias(Graph& graph, std::vector<vertex>& todosVertices, int paradasPorRegiao, int distanciaMinima) {
+    std::vector<std::vector<vertex>> melhoresVerticesPorRegiao = encontrarMelhoresVerticesParaTodasRegioes(graph, paradasPorRegiao, distanciaMinima);
 
-    // Vetor para armazenar todos os 12 vértices
+    // Vetor para armazenar as paradas de todas as regiões
     for (const auto& regioesDeVertice : melhoresVerticesPorRegiao) {
         todosVertices.insert(todosVertices.end(), regioesDeVertice.begin(), regioesDeVertice.end());
     }
 
-    int numVertices = todosVertices.size();  // Isso deve ser 12
+    int numVertices = todosVertices.size();
 
-    // Criando a matriz de distâncias 12x12
+    // Criando a matriz de distâncias entre as paradas
     std::vector<std::vector<int>> matrizDeDistancias(numVertices, std::vector<int>(numVertices, -1));
 
-    // Calculando as distâncias entre cada par de vértices
+    // Cada linha sai de uma única árvore de Dijkstra (uma busca por parada)
     for (int i = 0; i < numVertices; ++i) {
+        const int* distancias = SsspCache::compartilhado().consultar(graph, todosVertices[i]).distance;
         for (int j = 0; j < numVertices; ++j) {
             if (i != j) {
-                matrizDeDistancias[i][j] = calcularDistancia(graph, todosVertices[i], todosVertices[j]);
+                matrizDeDistancias[i][j] = distancias[todosVertices[j]];
             } else {
                 matrizDeDistancias[i][j] = 0;  // A distância de um vértice para ele mesmo é 0
             }
@@ -4,11 +4,14 @@
 #include "Graph.h"
 #include <vector>
 
+// Função para selecionar até k paradas em uma região, separadas por pelo menos distanciaMinima
+std::vector<vertex> selecionarParadasRegiao(const std::vector<vertex>& regiao, Graph& graph, int k, int distanciaMinima);
+
 // Função para encontrar os melhores vértices
-std::vector<std::vector<vertex>> encontrarMelhoresVerticesParaTodasRegioes(Graph &g);
+std::vector<std::vector<vertex>> encontrarMelhoresVerticesParaTodasRegioes(Graph &g, int paradasPorRegiao = 3, int distanciaMinima = 800);
 
 // Função para calcular a matriz de distâncias e coletar os vértices selecionados
-std::vector<std::vector<int>> calcularMatrizDeDistancias(Graph& graph, std::vector<vertex>& todosVertices);
+std::vector<std::vector<int>> calcularMatrizDeDistancias(Graph& graph, std::vector<vertex>& todosVertices, int paradasPorRegiao = 3, int distanciaMinima = 800);
 
 // Função para adicionar arestas ao grafo com base na matriz de distâncias
 void adicionarArestasAoGrafo(Graph& graph, const std::vector<std::vector<int>>& matrizDistancias);
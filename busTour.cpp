@@ -0,0 +1,257 @@
+#include "busTour.h"
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <deque>
+
+namespace {
+
+// Estado da busca local: o ciclo é guardado como vetor de paradas (tour) e a posição de cada
+// parada no vetor (pos), o que permite consultar sucessor/predecessor em O(1).
+class BuscaLocal {
+public:
+    BuscaLocal(const std::vector<std::vector<int>>& distancias, int numVizinhos, double orcamentoMs)
+        : m_dist(distancias), m_n(distancias.size()),
+          m_inicio(std::chrono::steady_clock::now()), m_orcamentoMs(orcamentoMs) {
+        construirVizinhos(numVizinhos);
+        construirVizinhoMaisProximo();
+    }
+
+    void otimizar() {
+        // Todas as paradas começam ativas (don't-look bit desligado)
+        std::deque<int> fila;
+        std::vector<bool> naFila(m_n, true);
+        for (int c = 0; c < m_n; ++c) { fila.push_back(c); }
+
+        int iteracoes = 0;
+        while (!fila.empty()) {
+            if ((++iteracoes & 63) == 0 && estourouOrcamento()) { break; }
+
+            int a = fila.front();
+            fila.pop_front();
+            naFila[a] = false;
+
+            std::vector<int> tocadas;
+            if (melhorar2Opt(a, tocadas) || melhorarOrOpt(a, tocadas)) {
+                // Reativa as extremidades das arestas alteradas (e a própria parada)
+                tocadas.push_back(a);
+                for (int c : tocadas) {
+                    if (!naFila[c]) {
+                        naFila[c] = true;
+                        fila.push_back(c);
+                    }
+                }
+            }
+        }
+    }
+
+    // Ciclo final começando pela parada 0
+    std::vector<int> ciclo() const {
+        std::vector<int> resultado(m_n);
+        int inicio = m_pos[0];
+        for (int i = 0; i < m_n; ++i) {
+            resultado[i] = m_tour[(inicio + i) % m_n];
+        }
+        return resultado;
+    }
+
+private:
+    long long d(int a, int b) const {
+        int valor = m_dist[a][b];
+        return valor < 0 ? INT_MAX : valor;  // -1 na matriz = sem caminho
+    }
+    int succ(int c) const { return m_tour[(m_pos[c] + 1) % m_n]; }
+    int pred(int c) const { return m_tour[(m_pos[c] + m_n - 1) % m_n]; }
+
+    bool estourouOrcamento() const {
+        double decorrido = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_inicio).count();
+        return decorrido > m_orcamentoMs;
+    }
+
+    // Lista das numVizinhos paradas mais próximas de cada parada, em ordem crescente de distância
+    void construirVizinhos(int numVizinhos) {
+        int k = std::min(numVizinhos, m_n - 1);
+        m_vizinhos.assign(m_n, {});
+        for (int a = 0; a < m_n; ++a) {
+            std::vector<int> candidatos;
+            for (int b = 0; b < m_n; ++b) {
+                if (b != a) { candidatos.push_back(b); }
+            }
+            std::partial_sort(candidatos.begin(), candidatos.begin() + k, candidatos.end(), [&](int x, int y) {
+                return d(a, x) < d(a, y);
+            });
+            candidatos.resize(k);
+            m_vizinhos[a] = candidatos;
+        }
+    }
+
+    // Ciclo inicial guloso a partir da parada 0
+    void construirVizinhoMaisProximo() {
+        std::vector<bool> visitado(m_n, false);
+        m_tour.clear();
+        int atual = 0;
+        visitado[atual] = true;
+        m_tour.push_back(atual);
+        for (int i = 1; i < m_n; ++i) {
+            int proximo = -1;
+            for (int c = 0; c < m_n; ++c) {
+                if (!visitado[c] && (proximo == -1 || d(atual, c) < d(atual, proximo))) {
+                    proximo = c;
+                }
+            }
+            visitado[proximo] = true;
+            m_tour.push_back(proximo);
+            atual = proximo;
+        }
+        m_pos.assign(m_n, 0);
+        for (int i = 0; i < m_n; ++i) { m_pos[m_tour[i]] = i; }
+    }
+
+    // Inverte o trecho do ciclo entre as posições i e j (inclusive, no sentido do ciclo).
+    // Inverter o complemento dá o mesmo ciclo, então inverte sempre o lado menor.
+    void inverter(int i, int j) {
+        int tamanho = (j - i + m_n) % m_n + 1;
+        if (2 * tamanho > m_n) {
+            int novoI = (j + 1) % m_n;
+            j = (i + m_n - 1) % m_n;
+            i = novoI;
+            tamanho = m_n - tamanho;
+        }
+        for (int t = 0; t < tamanho / 2; ++t) {
+            int a = m_tour[i];
+            int b = m_tour[j];
+            m_tour[i] = b;
+            m_pos[b] = i;
+            m_tour[j] = a;
+            m_pos[a] = j;
+            i = (i + 1) % m_n;
+            j = (j + m_n - 1) % m_n;
+        }
+    }
+
+    bool melhorar2Opt(int a, std::vector<int>& tocadas) {
+        // Sentido sucessor: troca (a, succ a) e (c, succ c) por (a, c) e (succ a, succ c)
+        int b = succ(a);
+        for (int c : m_vizinhos[a]) {
+            long long ganho = d(a, b) - d(a, c);
+            if (ganho <= 0) break;  // Vizinhos em ordem crescente: nenhum outro melhora
+            int dd = succ(c);
+            if (c == b || dd == a) continue;
+            if (d(a, c) + d(b, dd) < d(a, b) + d(c, dd)) {
+                inverter(m_pos[b], m_pos[c]);
+                tocadas.insert(tocadas.end(), {b, c, dd});
+                return true;
+            }
+        }
+
+        // Sentido predecessor: troca (pred a, a) e (pred c, c) por (a, c) e (pred a, pred c)
+        b = pred(a);
+        for (int c : m_vizinhos[a]) {
+            long long ganho = d(b, a) - d(a, c);
+            if (ganho <= 0) break;
+            int dd = pred(c);
+            if (c == b || dd == a) continue;
+            if (d(a, c) + d(b, dd) < d(b, a) + d(dd, c)) {
+                inverter(m_pos[a], m_pos[dd]);
+                tocadas.insert(tocadas.end(), {b, c, dd});
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Move um trecho de 1 a 3 paradas começando em a para perto de um de seus vizinhos
+    bool melhorarOrOpt(int a, std::vector<int>& tocadas) {
+        for (int tamanho = 1; tamanho <= 3 && tamanho + 2 <= m_n; ++tamanho) {
+            std::vector<int> trecho;
+            int e = a;
+            trecho.push_back(a);
+            for (int t = 1; t < tamanho; ++t) {
+                e = succ(e);
+                trecho.push_back(e);
+            }
+            int p = pred(a);
+            int nx = succ(e);
+            long long ganhoRemocao = d(p, a) + d(e, nx) - d(p, nx);
+            if (ganhoRemocao <= 0) continue;
+
+            auto noTrecho = [&](int c) { return std::find(trecho.begin(), trecho.end(), c) != trecho.end(); };
+
+            for (int extremo : {a, e}) {
+                for (int c : m_vizinhos[extremo]) {
+                    if (noTrecho(c)) continue;
+                    // Posições de inserção vizinhas a c no ciclo sem o trecho
+                    int opcoes[2][2] = {{c, c == p ? nx : succ(c)}, {c == nx ? p : pred(c), c}};
+                    for (auto& opcao : opcoes) {
+                        int x = opcao[0];
+                        int y = opcao[1];
+                        if (noTrecho(x) || noTrecho(y) || (x == p && y == nx)) continue;
+                        long long direto = d(x, a) + d(e, y);
+                        long long invertido = d(x, e) + d(a, y);
+                        long long custoInsercao = std::min(direto, invertido) - d(x, y);
+                        if (custoInsercao < ganhoRemocao) {
+                            moverTrecho(trecho, x, invertido < direto);
+                            tocadas.insert(tocadas.end(), {p, nx, x, y, e});
+                            return true;
+                        }
+                    }
+                }
+            }
+        }
+        return false;
+    }
+
+    // Remove o trecho do ciclo e o reinsere logo depois de x (invertido se pedido)
+    void moverTrecho(const std::vector<int>& trecho, int x, bool invertido) {
+        std::vector<int> novo;
+        novo.reserve(m_n);
+        int inicio = m_pos[trecho.back()];
+        for (int i = 1; i <= m_n; ++i) {
+            int c = m_tour[(inicio + i) % m_n];
+            if (std::find(trecho.begin(), trecho.end(), c) != trecho.end()) continue;
+            novo.push_back(c);
+            if (c == x) {
+                if (invertido) {
+                    novo.insert(novo.end(), trecho.rbegin(), trecho.rend());
+                } else {
+                    novo.insert(novo.end(), trecho.begin(), trecho.end());
+                }
+            }
+        }
+        m_tour = novo;
+        for (int i = 0; i < m_n; ++i) { m_pos[m_tour[i]] = i; }
+    }
+
+    const std::vector<std::vector<int>>& m_dist;
+    int m_n;
+    std::chrono::steady_clock::time_point m_inicio;
+    double m_orcamentoMs;
+    std::vector<std::vector<int>> m_vizinhos;
+    std::vector<int> m_tour;  // Paradas na ordem do ciclo
+    std::vector<int> m_pos;   // Posição de cada parada em m_tour
+};
+
+} // namespace
+
+std::vector<int> otimizarCicloParadas(const std::vector<std::vector<int>>& distancias, double orcamentoMs, int numVizinhos) {
+    int n = distancias.size();
+    if (n <= 3) {
+        // Com até 3 paradas todos os ciclos têm o mesmo comprimento
+        std::vector<int> ciclo(n);
+        for (int i = 0; i < n; ++i) { ciclo[i] = i; }
+        return ciclo;
+    }
+
+    BuscaLocal busca(distancias, numVizinhos, orcamentoMs);
+    busca.otimizar();
+    return busca.ciclo();
+}
+
+long long comprimentoCiclo(const std::vector<int>& ciclo, const std::vector<std::vector<int>>& distancias) {
+    long long total = 0;
+    for (size_t i = 0; i < ciclo.size(); ++i) {
+        int valor = distancias[ciclo[i]][ciclo[(i + 1) % ciclo.size()]];
+        total += valor < 0 ? INT_MAX : valor;
+    }
+    return total;
+}
@@ -0,0 +1,15 @@
+#ifndef BUSTOUR_H
+#define BUSTOUR_H
+
+#include <vector>
+
+// Otimiza a ordem de visita das paradas de um ciclo de ônibus a partir da matriz de distâncias
+// entre paradas. Começa pelo vizinho mais próximo e melhora com 2-opt e Or-opt usando listas de
+// vizinhos e don't-look bits, até não haver melhoria ou o orçamento de tempo (em ms) acabar.
+// Retorna os índices das paradas (linhas da matriz), começando pela parada 0.
+std::vector<int> otimizarCicloParadas(const std::vector<std::vector<int>>& distancias, double orcamentoMs = 200.0, int numVizinhos = 10);
+
+// Comprimento total do ciclo (incluindo a volta para a primeira parada)
+long long comprimentoCiclo(const std::vector<int>& ciclo, const std::vector<std::vector<int>>& distancias);
+
+#endif // BUSTOUR_H
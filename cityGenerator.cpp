@@ -0,0 +1,276 @@
+#include "cityGenerator.h"
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <unordered_map>
+#include "aleatorio.h"
+
+namespace {
+
+// Pesos dos tipos de edifício (residencial, comercial, industrial, turístico) por região
+const double PESOS_REGIAO[5][4] = {
+    {0, 0, 0, 0},
+    {0.9, 0.05, 0.04, 0.01},   // Região 1 (CEP 51000) é mais residencial
+    {0.9, 0.05, 0.04, 0.01},   // Região 2 (CEP 54000) é mais residencial
+    {0.60, 0.35, 0.01, 0.04},  // Região 3 (CEP 52000) é mais comercial e com atrações
+    {0.25, 0.05, 0.69, 0.01},  // Região 4 (CEP 53000) mais industrial
+};
+const char* CEP_REGIAO[5] = {"", "51000", "54000", "52000", "53000"};
+const char* NOMES_TIPO[4] = {"residential", "commercial", "industrial", "touristic"};
+const double MULTIPLICADORES_ESCAVACAO[5] = {0.6, 0.8, 1, 1.2, 1.4};
+
+// Sorteios por cruzamento: 0 decide se ele existe, 1..11 a rua na direção j e 12..22 a rua na
+// direção i (multiplicador de escavação e depois os 5 edifícios de cada lado)
+const int SORTEIO_EXISTE = 0;
+const int SORTEIOS_POR_RUA = 11;
+
+// Escreve em um buffer grande e descarrega no arquivo em blocos. Os números reais de uma cidade
+// se repetem muito (poucas distâncias distintas), então a formatação deles é memorizada.
+class SaidaBufferizada {
+public:
+    explicit SaidaBufferizada(FILE* arquivo) : m_arquivo(arquivo) { m_buffer.reserve(TAMANHO_BLOCO + 4096); }
+    ~SaidaBufferizada() { descarregar(); }
+
+    void texto(const char* s, size_t n) {
+        m_buffer.append(s, n);
+        if (m_buffer.size() >= TAMANHO_BLOCO) descarregar();
+    }
+    void texto(const char* s) { texto(s, std::strlen(s)); }
+    void texto(const std::string& s) { texto(s.data(), s.size()); }
+    void inteiro(long long valor) {
+        char numero[24];
+        auto fim = std::to_chars(numero, numero + sizeof(numero), valor).ptr;
+        texto(numero, fim - numero);
+    }
+    // Formato do json.dump do Python para os valores da cidade (%.17g, sem ".0" nos inteiros)
+    void real(double valor) {
+        auto it = m_reais.find(valor);
+        if (it == m_reais.end()) {
+            char numero[32];
+            std::snprintf(numero, sizeof(numero), "%.17g", valor);
+            it = m_reais.emplace(valor, numero).first;
+        }
+        texto(it->second);
+    }
+    void descarregar() {
+        if (!m_buffer.empty()) std::fwrite(m_buffer.data(), 1, m_buffer.size(), m_arquivo);
+        m_buffer.clear();
+    }
+
+private:
+    static const size_t TAMANHO_BLOCO = 1 << 20;
+    FILE* m_arquivo;
+    std::string m_buffer;
+    std::unordered_map<double, std::string> m_reais;
+};
+
+}  // namespace
+
+CidadeGerada::CidadeGerada(const ParametrosCidade& parametros) : m_parametros(parametros) {
+    const int N = parametros.linhas, M = parametros.colunas;
+    if (N <= 0 || M <= 0) return;
+
+    // Cruzamentos que existem, numerados em ordem de linha como os nós do JSON
+    std::vector<vertex> vertice((size_t)N * M, -1);
+    for (int i = 0; i < N; ++i) {
+        for (int j = 0; j < M; ++j) {
+            int64_t celula = (int64_t)i * M + j;
+            if (uniforme(aleatorio(celula, SORTEIO_EXISTE)) < parametros.probabilidadePular) continue;
+            vertice[celula] = m_celula.size();
+            m_celula.push_back(celula);
+            m_regiao.push_back(regiaoDaCelula(i, j));
+        }
+    }
+
+    // Ruas na ordem de main.py: de cada cruzamento, a rua para j + 1 (passando por cima dos
+    // cruzamentos pulados) e depois a rua para i + 1 se esse cruzamento existir
+    for (int i = 0; i < N; ++i) {
+        for (int j = 0; j < M; ++j) {
+            int64_t celula = (int64_t)i * M + j;
+            vertex v = vertice[celula];
+            if (v < 0) continue;
+            int k = j + 1;
+            while (k < M && vertice[celula + (k - j)] < 0) ++k;
+            if (k < M) adicionarRua(celula, 0, v, vertice[celula + (k - j)], parametros.comprimentoRua * (k - j));
+            if (i + 1 < N && vertice[celula + M] >= 0) adicionarRua(celula, 1, v, vertice[celula + M], parametros.comprimentoRua);
+        }
+    }
+}
+
+int CidadeGerada::regiaoDaCelula(int i, int j) const {
+    const int N = m_parametros.linhas, M = m_parametros.colunas;
+    if (i < N / 4) return 1;
+    if (i > 3 * N / 4) return 2;
+    return j < M / 2 ? 3 : 4;
+}
+
+uint64_t CidadeGerada::aleatorio(int64_t celula, int k) const {
+    return misturar(m_parametros.semente ^ misturar((uint64_t)celula * 32 + k));
+}
+
+int CidadeGerada::tipoEdificio(int64_t celula, int direcao, int lado, int k) const {
+    int i = celula / m_parametros.colunas, j = celula % m_parametros.colunas;
+    const double* pesos = PESOS_REGIAO[regiaoDaCelula(i, j)];
+    double u = uniforme(aleatorio(celula, 1 + direcao * SORTEIOS_POR_RUA + 1 + lado * 5 + k));
+    int tipo = 0;
+    while (tipo < 3 && u >= pesos[tipo]) u -= pesos[tipo++];
+    return tipo;
+}
+
+void CidadeGerada::adicionarRua(int64_t celula, int direcao, vertex de, vertex para, int distancia) {
+    RuaGerada rua{de, para, distancia, 0, {0, 0, 0, 0}, {0, 0, 0, 0}};
+    uint64_t sorteio = aleatorio(celula, 1 + direcao * SORTEIOS_POR_RUA);
+    rua.escavacao = distancia * MULTIPLICADORES_ESCAVACAO[sorteio % 5];
+    for (int k = 0; k < 5; ++k) {
+        ++rua.edificiosDe[tipoEdificio(celula, direcao, 0, k)];
+        ++rua.edificiosPara[tipoEdificio(celula, direcao, 1, k)];
+    }
+    m_ruas.push_back(rua);
+    m_celulaRua.push_back(celula * 2 + direcao);
+}
+
+std::string CidadeGerada::nodeId(vertex v) const {
+    int64_t celula = m_celula[v];
+    return "node_" + std::to_string(celula / m_parametros.colunas) + "_" + std::to_string(celula % m_parametros.colunas);
+}
+
+std::unique_ptr<Graph> CidadeGerada::construirGrafo() const {
+    std::unique_ptr<Graph> graph(new Graph(getNumVertices()));
+    for (vertex v = 0; v < getNumVertices(); ++v) {
+        std::string id = nodeId(v);
+        graph->setNodeId(v, id);
+        graph->setRegion(id, m_regiao[v]);
+    }
+    const ParametrosCidade& p = m_parametros;
+    for (const RuaGerada& rua : m_ruas) {
+        double tempoCaminhada = rua.distancia / p.velocidadeCaminhada;
+        double tempoTaxi = rua.distancia / p.velocidadeTaxi;
+        double precoTaxi = rua.distancia / 1000.0 * p.tarifaTaxi;
+        int custo = (int)rua.escavacao;  // Truncado como no loadFromJSON
+        for (int tipo = 0; tipo < 2; ++tipo) {
+            for (int lado = 0; lado < 2; ++lado) {
+                vertex a = lado == 0 ? rua.de : rua.para;
+                vertex b = lado == 0 ? rua.para : rua.de;
+                const uint8_t* e = lado == 0 ? rua.edificiosDe : rua.edificiosPara;
+                int preferencia = 4 * e[2] + 2 * e[0];
+                for (int sentido = 0; sentido < 2; ++sentido) {
+                    vertex v1 = sentido == 0 ? a : b;
+                    vertex v2 = sentido == 0 ? b : a;
+                    if (tipo == 0) {
+                        graph->addEdge(v1, v2, custo, rua.distancia, "walk", p.velocidadeCaminhada, 0, tempoCaminhada, e[0], e[1], e[3], e[2], preferencia);
+                    } else {
+                        graph->addEdge(v1, v2, custo, rua.distancia, "taxi", p.velocidadeTaxi, precoTaxi, tempoTaxi, e[0], e[1], e[3], e[2], preferencia);
+                    }
+                }
+            }
+        }
+    }
+    return graph;
+}
+
+bool CidadeGerada::gravarJSON(const std::string& arquivo, bool imoveis) const {
+    FILE* f = std::fopen(arquivo.c_str(), "wb");
+    if (!f) {
+        std::cerr << "Nao foi possivel abrir " << arquivo << std::endl;
+        return false;
+    }
+    const ParametrosCidade& p = m_parametros;
+    {
+        SaidaBufferizada saida(f);
+        auto escreverId = [&](vertex v) {
+            saida.texto("\"node_");
+            saida.inteiro(m_celula[v] / p.colunas);
+            saida.texto("_");
+            saida.inteiro(m_celula[v] % p.colunas);
+            saida.texto("\"");
+        };
+
+        saida.texto("{\"nodes\":[");
+        for (vertex v = 0; v < getNumVertices(); ++v) {
+            saida.texto(v == 0 ? "{\"id\":" : ",{\"id\":");
+            escreverId(v);
+            saida.texto(",\"location\":[");
+            saida.inteiro(m_celula[v] / p.colunas);
+            saida.texto(",");
+            saida.inteiro(m_celula[v] % p.colunas);
+            saida.texto("],\"transport_options\":[\"taxi\",\"non_motorized\"],\"region\":");
+            saida.inteiro(m_regiao[v]);
+            saida.texto("}");
+        }
+
+        // Quatro arestas por rua, como em main.py: caminhada de -> para e para -> de, depois táxi
+        saida.texto("],\"edges\":[");
+        bool primeira = true;
+        for (const RuaGerada& rua : m_ruas) {
+            for (int tipo = 0; tipo < 2; ++tipo) {
+                double velocidade = tipo == 0 ? p.velocidadeCaminhada : p.velocidadeTaxi;
+                for (int lado = 0; lado < 2; ++lado) {
+                    const uint8_t* e = lado == 0 ? rua.edificiosDe : rua.edificiosPara;
+                    saida.texto(primeira ? "{\"from\":" : ",{\"from\":");
+                    primeira = false;
+                    escreverId(lado == 0 ? rua.de : rua.para);
+                    saida.texto(",\"to\":");
+                    escreverId(lado == 0 ? rua.para : rua.de);
+                    saida.texto(tipo == 0 ? ",\"transport_type\":\"walk\",\"max_speed\":" : ",\"transport_type\":\"taxi\",\"max_speed\":");
+                    saida.real(velocidade);
+                    saida.texto(",\"distance\":");
+                    saida.inteiro(rua.distancia);
+                    saida.texto(",\"price_cost\":");
+                    saida.real(tipo == 0 ? 0.0 : rua.distancia / 1000.0 * p.tarifaTaxi);
+                    saida.texto(",\"time_cost\":");
+                    saida.real(rua.distancia / velocidade);
+                    saida.texto(",\"excavation_cost\":");
+                    saida.real(rua.escavacao);
+                    saida.texto(",\"num_residencial\":");
+                    saida.inteiro(e[0]);
+                    saida.texto(",\"num_commercial\":");
+                    saida.inteiro(e[1]);
+                    saida.texto(",\"num_touristic\":");
+                    saida.inteiro(e[3]);
+                    saida.texto(",\"num_industrial\":");
+                    saida.inteiro(e[2]);
+                    saida.texto(",\"bus_preference\":");
+                    saida.inteiro(4 * e[2] + 2 * e[0]);
+                    saida.texto("}");
+                }
+            }
+        }
+
+        saida.texto("],\"properties\":[");
+        if (imoveis) {
+            // Numeração de main.py: 10 * j + 2 * k do lado "de" e + 1 do lado "para"; a rua leva o
+            // nome da linha i do cruzamento de origem
+            primeira = true;
+            for (size_t r = 0; r < m_ruas.size(); ++r) {
+                const RuaGerada& rua = m_ruas[r];
+                int64_t celula = m_celulaRua[r] / 2;
+                int direcao = m_celulaRua[r] % 2;
+                int i = celula / p.colunas, j = celula % p.colunas;
+                for (int k = 0; k < 5; ++k) {
+                    for (int lado = 0; lado < 2; ++lado) {
+                        saida.texto(primeira ? "{\"cep\":\"" : ",{\"cep\":\"");
+                        primeira = false;
+                        saida.texto(CEP_REGIAO[regiaoDaCelula(i, j)]);
+                        saida.texto("\",\"street\":\"Rua ");
+                        saida.inteiro(i + 1);
+                        saida.texto("\",\"number\":");
+                        saida.inteiro(10 * j + 2 * k + lado);
+                        saida.texto(",\"type\":\"");
+                        saida.texto(NOMES_TIPO[tipoEdificio(celula, direcao, lado, k)]);
+                        saida.texto("\",\"from\":");
+                        escreverId(lado == 0 ? rua.de : rua.para);
+                        saida.texto(",\"to\":");
+                        escreverId(lado == 0 ? rua.para : rua.de);
+                        saida.texto("}");
+                    }
+                }
+            }
+        }
+        saida.texto("]}\n");
+    }
+    bool ok = std::ferror(f) == 0;
+    ok = std::fclose(f) == 0 && ok;
+    if (!ok) std::cerr << "Erro ao gravar " << arquivo << std::endl;
+    return ok;
+}
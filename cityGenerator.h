@@ -0,0 +1,67 @@
+#ifndef CITYGENERATOR_H
+#define CITYGENERATOR_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "graph.h"
+
+// Parâmetros do modelo de cidade de main.py
+struct ParametrosCidade {
+    int linhas = 24;                   // N: ruas horizontais
+    int colunas = 16;                  // M: ruas verticais
+    uint64_t semente = 1;
+    double probabilidadePular = 0.3;   // Chance de um cruzamento não existir
+    int comprimentoRua = 200;          // Metros entre cruzamentos vizinhos
+    double velocidadeTaxi = 15;        // m/s
+    double tarifaTaxi = 4;             // Reais por km
+    double velocidadeCaminhada = 1.5;  // m/s
+};
+
+// Rua entre dois cruzamentos, com os edifícios de cada lado na ordem de main.py:
+// residencial, comercial, industrial, turístico
+struct RuaGerada {
+    vertex de;
+    vertex para;
+    int distancia;
+    double escavacao;
+    uint8_t edificiosDe[4];
+    uint8_t edificiosPara[4];
+};
+
+// Cidade sintética no modelo de main.py: grade N x M onde 30% dos cruzamentos são pulados, ruas
+// de uma linha que passam por cima dos pulados (mais longas), 4 regiões, 5 edifícios de cada
+// lado sorteados pelos pesos da região e arestas de caminhada e táxi nos dois sentidos. Cada
+// sorteio é derivado de (semente, cruzamento, índice), então a mesma semente gera a mesma cidade.
+// O grafo pode ser montado direto na memória ou gravado como JSON compacto para o loadFromJSON.
+class CidadeGerada {
+public:
+    explicit CidadeGerada(const ParametrosCidade& parametros = ParametrosCidade());
+
+    int getNumVertices() const { return m_celula.size(); }
+    const std::vector<RuaGerada>& ruas() const { return m_ruas; }
+    std::string nodeId(vertex v) const;
+    int regiao(vertex v) const { return m_regiao[v]; }
+
+    // Mesmo Graph que loadFromJSON montaria do JSON gravado (cada aresta do JSON nos dois sentidos)
+    std::unique_ptr<Graph> construirGrafo() const;
+
+    // JSON compacto com o formato de city_graph.json; `imoveis` inclui a lista de edifícios
+    bool gravarJSON(const std::string& arquivo, bool imoveis = false) const;
+
+private:
+    int regiaoDaCelula(int i, int j) const;
+    // Tipo (0..3) do k-ésimo edifício de um lado da rua que sai de `celula` na direção dada
+    int tipoEdificio(int64_t celula, int direcao, int lado, int k) const;
+    uint64_t aleatorio(int64_t celula, int k) const;
+    void adicionarRua(int64_t celula, int direcao, vertex de, vertex para, int distancia);
+
+    ParametrosCidade m_parametros;
+    std::vector<int64_t> m_celula;   // Cruzamento i * colunas + j de cada vértice
+    std::vector<uint8_t> m_regiao;
+    std::vector<RuaGerada> m_ruas;
+    std::vector<int64_t> m_celulaRua;  // Cruzamento de origem e direção (bit 0) de cada rua
+};
+
+#endif // CITYGENERATOR_H
@@ -0,0 +1,222 @@
+#include "demand.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <queue>
+#include <thread>
+#include "aleatorio.h"
+#include "newMetro.h"
+
+namespace {
+
+int numThreadsPadrao(int numThreads) {
+    if (numThreads > 0) return numThreads;
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+}  // namespace
+
+TabelaAlias::TabelaAlias(const std::vector<double>& pesos) {
+    size_t n = pesos.size();
+    double total = 0;
+    for (double p : pesos) total += std::max(p, 0.0);
+    if (n == 0 || !(total > 0)) return;
+
+    // Vose: colunas com probabilidade escalada abaixo de 1 são completadas por colunas acima de 1
+    std::vector<double> escalado(n);
+    std::vector<int32_t> pequenos, grandes;
+    for (size_t i = 0; i < n; ++i) {
+        escalado[i] = std::max(pesos[i], 0.0) * n / total;
+        (escalado[i] < 1.0 ? pequenos : grandes).push_back(i);
+    }
+    m_prob.assign(n, 1.0f);
+    m_alias.resize(n);
+    for (size_t i = 0; i < n; ++i) m_alias[i] = i;
+    while (!pequenos.empty() && !grandes.empty()) {
+        int32_t pequeno = pequenos.back();
+        pequenos.pop_back();
+        int32_t grande = grandes.back();
+        m_prob[pequeno] = escalado[pequeno];
+        m_alias[pequeno] = grande;
+        escalado[grande] -= 1.0 - escalado[pequeno];
+        if (escalado[grande] < 1.0) {
+            grandes.pop_back();
+            pequenos.push_back(grande);
+        }
+    }
+    // O que sobra nas duas listas tem probabilidade 1 (diferenças só de arredondamento)
+}
+
+GeradorDemanda::GeradorDemanda(Graph& graph, const ParametrosDemanda& parametros) : m_parametros(parametros) {
+    const int numVertices = graph.getNumVertices();
+    if (numVertices == 0) return;
+
+    // Produção e atração de cada vértice pelos edifícios das ruas que saem dele
+    std::vector<double> producao(numVertices, 0), atracao(numVertices, 0);
+    for (vertex v = 0; v < numVertices; ++v) {
+        for (Edge* edge = graph.getEdges(v); edge; edge = edge->next()) {
+            producao[v] += edge->num_residencial();
+            atracao[v] += parametros.atracaoResidencial * edge->num_residencial() +
+                          parametros.atracaoComercial * edge->num_commercial() +
+                          parametros.atracaoTuristica * edge->num_touristic() +
+                          parametros.atracaoIndustrial * edge->num_industrial();
+        }
+    }
+
+    // Zonas: bolas de BFS a partir do primeiro vértice ainda sem zona
+    int tamanho = std::max(parametros.tamanhoZona, 1);
+    int maxZonas = std::max(parametros.maxZonas, 1);
+    tamanho = std::max(tamanho, (numVertices + maxZonas - 1) / maxZonas);
+    m_zona.assign(numVertices, -1);
+    std::vector<vertex> centros;
+    for (vertex inicio = 0; inicio < numVertices; ++inicio) {
+        if (m_zona[inicio] != -1) continue;
+        int zona = centros.size();
+        centros.push_back(inicio);
+        m_vertices.emplace_back();
+        std::queue<vertex> fila;
+        fila.push(inicio);
+        m_zona[inicio] = zona;
+        while (!fila.empty() && (int)m_vertices[zona].size() < tamanho) {
+            vertex v = fila.front();
+            fila.pop();
+            m_vertices[zona].push_back(v);
+            for (Edge* edge = graph.getEdges(v); edge; edge = edge->next()) {
+                vertex w = edge->v2();
+                if (m_zona[w] == -1 && (int)(m_vertices[zona].size() + fila.size()) < tamanho) {
+                    m_zona[w] = zona;
+                    fila.push(w);
+                }
+            }
+        }
+    }
+    m_numZonas = centros.size();
+
+    // Distâncias entre os centros das zonas: um Dijkstra por centro, em paralelo
+    std::vector<double> custo((size_t)m_numZonas * m_numZonas, 0);
+    std::vector<double> custoInterno(m_numZonas, 0);
+    int numThreads = std::min(numThreadsPadrao(0), m_numZonas);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; ++t) {
+        threads.emplace_back([&, t]() {
+            std::vector<vertex> parent(numVertices);
+            std::vector<int> distancia(numVertices);
+            for (int a = t; a < m_numZonas; a += numThreads) {
+                Dijkstra::cptDijkstraFast(centros[a], parent.data(), distancia.data(), graph);
+                for (int b = 0; b < m_numZonas; ++b) {
+                    int d = distancia[centros[b]];
+                    custo[(size_t)a * m_numZonas + b] = d == INT_MAX ? -1 : d;
+                }
+                // Dentro da zona: distância média do centro aos vértices dela
+                double soma = 0;
+                int alcancados = 0;
+                for (vertex v : m_vertices[a]) {
+                    if (distancia[v] == INT_MAX) continue;
+                    soma += distancia[v];
+                    ++alcancados;
+                }
+                custoInterno[a] = alcancados ? soma / alcancados : 0;
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    // Tabelas de sorteio
+    m_origens = TabelaAlias(producao);
+    std::vector<double> atracaoZona(m_numZonas, 0);
+    m_destinoNaZona.resize(m_numZonas);
+    for (int z = 0; z < m_numZonas; ++z) {
+        std::vector<double> pesos;
+        for (vertex v : m_vertices[z]) {
+            pesos.push_back(atracao[v]);
+            atracaoZona[z] += atracao[v];
+        }
+        m_destinoNaZona[z] = TabelaAlias(pesos);
+    }
+    m_zonaDestino.resize(m_numZonas);
+    for (int a = 0; a < m_numZonas; ++a) {
+        std::vector<double> pesos(m_numZonas, 0);
+        for (int b = 0; b < m_numZonas; ++b) {
+            double c = a == b ? custoInterno[a] : custo[(size_t)a * m_numZonas + b];
+            if (c < 0) continue;  // Zona inalcançável
+            pesos[b] = atracaoZona[b] * std::exp(-parametros.beta * c / 1000.0);
+        }
+        m_zonaDestino[a] = TabelaAlias(pesos);
+    }
+}
+
+uint64_t GeradorDemanda::aleatorio(uint64_t i, uint64_t k) const {
+    return misturar(m_parametros.semente ^ misturar(i * 16 + k));
+}
+
+ViagemOD GeradorDemanda::viagem(uint64_t i) const {
+    ViagemOD viagem{-1, -1, 0};
+    if (!valido()) return viagem;
+
+    // Sorteios que caem numa origem sem destino alcançável (ou com destino igual à origem) são refeitos
+    for (int tentativa = 0; tentativa < 4; ++tentativa) {
+        uint64_t k = tentativa * 3;
+        vertex origem = m_origens.amostrar(aleatorio(i, k));
+        const TabelaAlias& zonas = m_zonaDestino[m_zona[origem]];
+        viagem.origem = origem;
+        if (zonas.vazia()) continue;
+        int zona = zonas.amostrar(aleatorio(i, k + 1));
+        viagem.destino = m_vertices[zona][m_destinoNaZona[zona].amostrar(aleatorio(i, k + 2))];
+        if (viagem.destino != origem) break;
+    }
+
+    // Partida: picos da manhã (8h) e da tarde (18h) mais uma parcela espalhada pelo dia
+    const double PI = 3.14159265358979323846;
+    double escolha = uniformePositivo(aleatorio(i, 12));
+    double normal = std::sqrt(-2.0 * std::log(uniformePositivo(aleatorio(i, 13)))) * std::cos(2 * PI * uniformePositivo(aleatorio(i, 14)));
+    double minuto;
+    if (escolha < 0.35) {
+        minuto = 480 + 60 * normal;
+    } else if (escolha < 0.7) {
+        minuto = 1080 + 90 * normal;
+    } else {
+        minuto = 1440 * uniformePositivo(aleatorio(i, 15));
+    }
+    viagem.partida = std::min(std::max(minuto, 0.0), 1439.99);
+    return viagem;
+}
+
+std::vector<ViagemOD> GeradorDemanda::gerar(size_t numViagens, int numThreads) const {
+    std::vector<ViagemOD> viagens(numViagens);
+    numThreads = (int)std::min<size_t>(numThreadsPadrao(numThreads), std::max<size_t>(numViagens, 1));
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; ++t) {
+        threads.emplace_back([&, t]() {
+            size_t inicio = numViagens * t / numThreads;
+            size_t fim = numViagens * (t + 1) / numThreads;
+            for (size_t i = inicio; i < fim; ++i) viagens[i] = viagem(i);
+        });
+    }
+    for (auto& t : threads) t.join();
+    return viagens;
+}
+
+size_t GeradorDemanda::bytes() const {
+    size_t total = m_zona.size() * sizeof(int32_t) + m_origens.bytes();
+    for (const auto& vertices : m_vertices) total += vertices.size() * sizeof(vertex);
+    for (const auto& tabela : m_zonaDestino) total += tabela.bytes();
+    for (const auto& tabela : m_destinoNaZona) total += tabela.bytes();
+    return total;
+}
+
+bool gravarDemandaJSONL(const Graph& graph, const std::vector<ViagemOD>& viagens, double orcamento, const std::string& arquivo) {
+    std::ofstream saida(arquivo);
+    if (!saida.is_open()) {
+        std::cerr << "Nao foi possivel abrir " << arquivo << std::endl;
+        return false;
+    }
+    for (const ViagemOD& viagem : viagens) {
+        if (viagem.origem < 0 || viagem.destino < 0) continue;
+        saida << "{\"origin\": \"" << graph.getNodeId(viagem.origem) << "\", \"destination\": \""
+              << graph.getNodeId(viagem.destino) << "\", \"budget\": " << orcamento
+              << ", \"departure\": " << std::round(viagem.partida * 100) / 100 << "}\n";
+    }
+    return (bool)saida;
+}
@@ -0,0 +1,87 @@
+#ifndef DEMAND_H
+#define DEMAND_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "graph.h"
+
+// Tabela de alias (Vose): sorteia um índice com probabilidade proporcional ao peso em O(1)
+class TabelaAlias {
+public:
+    TabelaAlias() {}
+    explicit TabelaAlias(const std::vector<double>& pesos);  // Pesos negativos contam como 0
+
+    bool vazia() const { return m_prob.empty(); }
+    size_t bytes() const { return m_prob.size() * sizeof(float) + m_alias.size() * sizeof(int32_t); }
+
+    // Os 32 bits altos escolhem a coluna e os 32 baixos decidem entre ela e o seu alias
+    int amostrar(uint64_t aleatorio) const {
+        uint32_t coluna = (uint32_t)(((aleatorio >> 32) * m_prob.size()) >> 32);
+        float moeda = (uint32_t)aleatorio * (1.0f / 4294967296.0f);
+        return moeda < m_prob[coluna] ? (int)coluna : m_alias[coluna];
+    }
+
+private:
+    std::vector<float> m_prob;
+    std::vector<int32_t> m_alias;
+};
+
+struct ParametrosDemanda {
+    uint64_t semente = 1;
+    double beta = 0.3;       // Decaimento da atração por km de distância (modelo gravitacional)
+    int tamanhoZona = 16;    // Vértices por zona na matriz de custos entre zonas
+    int maxZonas = 1024;     // Limite de zonas (a matriz tem maxZonas^2 entradas)
+
+    // Produção de viagens de cada vértice: edifícios residenciais nas ruas que saem dele.
+    // Atração: soma ponderada dos edifícios das mesmas ruas.
+    double atracaoResidencial = 0.2;
+    double atracaoComercial = 1.0;
+    double atracaoTuristica = 0.8;
+    double atracaoIndustrial = 0.6;
+};
+
+// Par origem-destino com horário de partida (minuto do dia)
+struct ViagemOD {
+    vertex origem;
+    vertex destino;
+    float partida;
+};
+
+// Gerador de demanda por modelo gravitacional: a origem é sorteada pela produção dos vértices,
+// a zona de destino com peso atração(zona) * exp(-beta * distância entre zonas) e o destino
+// pela atração dos vértices da zona. As zonas são bolas de BFS com ~tamanhoZona vértices e a
+// distância entre elas é a do Dijkstra entre os seus centros. Cada viagem i usa só números
+// aleatórios derivados de (semente, i), então o resultado não depende do número de threads.
+class GeradorDemanda {
+public:
+    GeradorDemanda(Graph& graph, const ParametrosDemanda& parametros = ParametrosDemanda());
+
+    // false se nenhum vértice produz ou atrai viagens
+    bool valido() const { return !m_origens.vazia() && m_numZonas > 0; }
+
+    ViagemOD viagem(uint64_t i) const;
+
+    // Viagens 0..numViagens-1, geradas em paralelo (numThreads <= 0 usa todos os núcleos)
+    std::vector<ViagemOD> gerar(size_t numViagens, int numThreads = 0) const;
+
+    int getNumZonas() const { return m_numZonas; }
+    int zonaDe(vertex v) const { return m_zona[v]; }
+    size_t bytes() const;
+
+private:
+    uint64_t aleatorio(uint64_t i, uint64_t k) const;
+
+    ParametrosDemanda m_parametros;
+    int m_numZonas = 0;
+    std::vector<int32_t> m_zona;                    // Zona de cada vértice
+    std::vector<std::vector<vertex>> m_vertices;    // Vértices de cada zona
+    TabelaAlias m_origens;                          // Vértices por produção
+    std::vector<TabelaAlias> m_zonaDestino;         // Por zona de origem: zonas de destino
+    std::vector<TabelaAlias> m_destinoNaZona;       // Por zona: vértices por atração
+};
+
+// Grava as viagens no formato de consulta em lote (batchRoutes.h), com "departure" em minutos
+bool gravarDemandaJSONL(const Graph& graph, const std::vector<ViagemOD>& viagens, double orcamento, const std::string& arquivo);
+
+#endif // DEMAND_H
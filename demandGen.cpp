@@ -0,0 +1,86 @@
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include "external/json.hpp"
+#include "graph.h"
+#include "demand.h"
+
+using json = nlohmann::json;
+
+// Gera a demanda de um dia (pares origem-destino pelo modelo gravitacional de demand.h) no formato
+// de consultas do main --batch.
+// Compilação: g++ -std=c++17 -O3 -pthread demandGen.cpp demand.cpp Graph.cpp newMetro.cpp dataStructures.cpp
+//             ssspCache.cpp stats.cpp -o demandGen
+// Uso: demandGen saida.jsonl [--viagens N] [--semente S] [--beta B] [--orcamento K]
+//                [--zona Z] [--threads T] [--grafo city_graph.json]
+int main(int argc, char* argv[]) {
+    std::string arquivoGrafo = "city_graph.json";
+    std::string arquivoSaida;
+    size_t numViagens = 1000000;
+    double orcamento = 20;
+    int numThreads = 0;
+    ParametrosDemanda parametros;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--viagens") == 0 && i + 1 < argc) {
+            numViagens = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--semente") == 0 && i + 1 < argc) {
+            parametros.semente = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--beta") == 0 && i + 1 < argc) {
+            parametros.beta = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--orcamento") == 0 && i + 1 < argc) {
+            orcamento = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--zona") == 0 && i + 1 < argc) {
+            parametros.tamanhoZona = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            numThreads = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--grafo") == 0 && i + 1 < argc) {
+            arquivoGrafo = argv[++i];
+        } else if (arquivoSaida.empty() && argv[i][0] != '-') {
+            arquivoSaida = argv[i];
+        } else {
+            std::cerr << "Argumento desconhecido: " << argv[i] << std::endl;
+            return 1;
+        }
+    }
+    if (arquivoSaida.empty()) {
+        std::cerr << "Uso: " << argv[0] << " saida.jsonl [--viagens N] [--semente S] [--beta B] [--orcamento K]"
+                  << " [--zona Z] [--threads T] [--grafo city_graph.json]" << std::endl;
+        return 1;
+    }
+
+    // Conta os nós antes de criar o Graph, como em main.cpp
+    std::ifstream file(arquivoGrafo);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open " << arquivoGrafo << std::endl;
+        return 1;
+    }
+    json graphData;
+    file >> graphData;
+    Graph graph(graphData["nodes"].size());
+    if (!graph.loadFromJSON(arquivoGrafo)) {
+        return 1;
+    }
+
+    auto inicio = std::chrono::steady_clock::now();
+    GeradorDemanda gerador(graph, parametros);
+    if (!gerador.valido()) {
+        std::cerr << "O grafo nao tem vertices que produzem e atraem viagens" << std::endl;
+        return 1;
+    }
+    auto preparado = std::chrono::steady_clock::now();
+    std::vector<ViagemOD> viagens = gerador.gerar(numViagens, numThreads);
+    auto gerado = std::chrono::steady_clock::now();
+    if (!gravarDemandaJSONL(graph, viagens, orcamento, arquivoSaida)) {
+        return 1;
+    }
+    auto gravado = std::chrono::steady_clock::now();
+
+    auto segundos = [](auto a, auto b) { return std::chrono::duration<double>(b - a).count(); };
+    std::cout << "Zonas: " << gerador.getNumZonas() << std::endl;
+    std::cout << "Viagens: " << viagens.size() << std::endl;
+    std::cout << "Preparo: " << segundos(inicio, preparado) << " s, sorteio: " << segundos(preparado, gerado)
+              << " s, gravacao: " << segundos(gerado, gravado) << " s" << std::endl;
+    return 0;
+}
@@ -0,0 +1,207 @@
+#include "eventLog.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+const char ASSINATURA[8] = {'P', 'A', 'A', 'E', 'V', 'L', 'O', 'G'};
+const uint32_t VERSAO = 1;
+const size_t TAMANHO_BLOCO = 1 << 16;  // Eventos por bloco colunar
+
+template<class T>
+void gravar(std::ofstream& arquivo, const T* dados, size_t n) {
+    arquivo.write(reinterpret_cast<const char*>(dados), n * sizeof(T));
+}
+
+template<class T>
+bool ler(std::ifstream& arquivo, T* dados, size_t n) {
+    arquivo.read(reinterpret_cast<char*>(dados), n * sizeof(T));
+    return (bool)arquivo;
+}
+
+}  // namespace
+
+AnelEventos::AnelEventos(size_t capacidade) {
+    size_t tamanho = 1;
+    while (tamanho < capacidade) tamanho <<= 1;
+    m_slots.resize(tamanho);
+    m_mascara = tamanho - 1;
+}
+
+size_t AnelEventos::retirar(RegistroEvento* destino, size_t maximo) {
+    size_t cauda = m_cauda.load(std::memory_order_relaxed);
+    size_t disponiveis = std::min(maximo, m_cabeca.load(std::memory_order_acquire) - cauda);
+    for (size_t i = 0; i < disponiveis; ++i) {
+        destino[i] = m_slots[(cauda + i) & m_mascara];
+    }
+    m_cauda.store(cauda + disponiveis, std::memory_order_release);
+    return disponiveis;
+}
+
+EventLog::EventLog(const std::string& arquivo, int numProdutores, size_t capacidadeAnel)
+    : m_arquivo(arquivo, std::ios::binary | std::ios::trunc) {
+    if (!m_arquivo.is_open()) {
+        std::cerr << "Nao foi possivel abrir o log de eventos: " << arquivo << std::endl;
+        return;
+    }
+    for (int i = 0; i < std::max(1, numProdutores); ++i) {
+        m_aneis.emplace_back(new AnelEventos(capacidadeAnel));
+    }
+    m_blocoAgente.reserve(TAMANHO_BLOCO);
+    m_blocoVertice.reserve(TAMANHO_BLOCO);
+    m_blocoTempo.reserve(TAMANHO_BLOCO);
+    gravarCabecalho(0);  // Reescrito com os totais em fechar()
+    m_aberto = true;
+    m_escritora = std::thread(&EventLog::escrever, this);
+}
+
+EventLog::~EventLog() {
+    fechar();
+}
+
+void EventLog::escrever() {
+    std::vector<RegistroEvento> lote(4096);
+    while (true) {
+        // parar é lido antes de esvaziar: se já estava ligado, nada mais entra depois desta passada
+        bool parar = m_parar.load(std::memory_order_acquire);
+        size_t retirados = 0;
+        for (auto& anel : m_aneis) {
+            size_t n;
+            while ((n = anel->retirar(lote.data(), lote.size())) > 0) {
+                for (size_t i = 0; i < n; ++i) {
+                    m_blocoAgente.push_back(lote[i].agente);
+                    m_blocoVertice.push_back(lote[i].vertice);
+                    m_blocoTempo.push_back(lote[i].tempo);
+                    if (m_blocoAgente.size() == TAMANHO_BLOCO) gravarBloco();
+                }
+                retirados += n;
+            }
+        }
+        if (retirados == 0) {
+            if (parar) break;
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    }
+    gravarBloco();
+}
+
+void EventLog::gravarBloco() {
+    uint32_t n = m_blocoAgente.size();
+    if (n == 0) return;
+    gravar(m_arquivo, &n, 1);
+    gravar(m_arquivo, m_blocoAgente.data(), n);
+    gravar(m_arquivo, m_blocoVertice.data(), n);
+    gravar(m_arquivo, m_blocoTempo.data(), n);
+    m_numEventos += n;
+    m_blocoAgente.clear();
+    m_blocoVertice.clear();
+    m_blocoTempo.clear();
+}
+
+void EventLog::gravarCabecalho(uint64_t posicaoNomes) {
+    uint32_t reservado = 0;
+    m_arquivo.seekp(0);
+    m_arquivo.write(ASSINATURA, sizeof(ASSINATURA));
+    gravar(m_arquivo, &VERSAO, 1);
+    gravar(m_arquivo, &reservado, 1);
+    gravar(m_arquivo, &m_numEventos, 1);
+    gravar(m_arquivo, &posicaoNomes, 1);
+}
+
+void EventLog::fechar() {
+    if (!m_aberto) return;
+    m_parar.store(true, std::memory_order_release);
+    m_escritora.join();
+
+    uint64_t posicaoNomes = 0;
+    if (!m_nomes.empty()) {
+        m_arquivo.seekp(0, std::ios::end);
+        posicaoNomes = m_arquivo.tellp();
+        uint32_t quantidade = m_nomes.size();
+        gravar(m_arquivo, &quantidade, 1);
+        for (const std::string& nome : m_nomes) {
+            uint32_t tamanho = nome.size();
+            gravar(m_arquivo, &tamanho, 1);
+            m_arquivo.write(nome.data(), tamanho);
+        }
+    }
+    gravarCabecalho(posicaoNomes);
+    m_arquivo.close();
+    m_aberto = false;
+}
+
+bool lerLogEventos(const std::string& arquivo, LogEventos& log) {
+    std::ifstream entrada(arquivo, std::ios::binary);
+    if (!entrada.is_open()) {
+        std::cerr << "Nao foi possivel abrir o log de eventos: " << arquivo << std::endl;
+        return false;
+    }
+
+    char assinatura[8];
+    uint32_t versao, reservado;
+    uint64_t numEventos, posicaoNomes;
+    if (!ler(entrada, assinatura, 8) || std::memcmp(assinatura, ASSINATURA, 8) != 0 ||
+        !ler(entrada, &versao, 1) || !ler(entrada, &reservado, 1) ||
+        !ler(entrada, &numEventos, 1) || !ler(entrada, &posicaoNomes, 1)) {
+        std::cerr << "Arquivo nao e um log de eventos: " << arquivo << std::endl;
+        return false;
+    }
+    if (versao != VERSAO) {
+        std::cerr << "Versao de log nao suportada: " << versao << std::endl;
+        return false;
+    }
+
+    // O cabeçalho só é confiável depois de conferido com o tamanho do arquivo: um log truncado ou
+    // corrompido não pode pedir uma alocação maior que os dados que realmente existem
+    uint64_t inicioEventos = entrada.tellg();
+    entrada.seekg(0, std::ios::end);
+    uint64_t tamanhoArquivo = entrada.tellg();
+    entrada.seekg(inicioEventos);
+    const uint64_t bytesEvento = sizeof(log.agente[0]) + sizeof(log.vertice[0]) + sizeof(log.tempo[0]);
+    if (numEventos > (tamanhoArquivo - inicioEventos) / bytesEvento) {
+        std::cerr << "Log de eventos truncado ou corrompido: " << numEventos << " eventos no cabecalho, "
+                  << tamanhoArquivo << " bytes no arquivo: " << arquivo << std::endl;
+        return false;
+    }
+
+    log.agente.resize(numEventos);
+    log.vertice.resize(numEventos);
+    log.tempo.resize(numEventos);
+    uint64_t lidos = 0;
+    while (lidos < numEventos) {
+        uint32_t n;
+        if (!ler(entrada, &n, 1) || n > numEventos - lidos ||
+            !ler(entrada, log.agente.data() + lidos, n) ||
+            !ler(entrada, log.vertice.data() + lidos, n) ||
+            !ler(entrada, log.tempo.data() + lidos, n)) {
+            std::cerr << "Log de eventos truncado: " << arquivo << std::endl;
+            return false;
+        }
+        lidos += n;
+    }
+
+    log.nomes.clear();
+    if (posicaoNomes != 0) {
+        entrada.seekg(posicaoNomes);
+        // Cada nome ocupa pelo menos o seu tamanho (uint32)
+        uint32_t quantidade;
+        uint64_t restante = posicaoNomes < tamanhoArquivo ? tamanhoArquivo - posicaoNomes : 0;
+        if (!ler(entrada, &quantidade, 1) || quantidade > restante / sizeof(uint32_t)) {
+            std::cerr << "Tabela de nomes truncada: " << arquivo << std::endl;
+            return false;
+        }
+        log.nomes.resize(quantidade);
+        for (std::string& nome : log.nomes) {
+            uint32_t tamanho;
+            if (!ler(entrada, &tamanho, 1) || tamanho > restante) {
+                std::cerr << "Tabela de nomes truncada: " << arquivo << std::endl;
+                return false;
+            }
+            nome.resize(tamanho);
+            if (!ler(entrada, &nome[0], tamanho)) return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,102 @@
+#ifndef EVENTLOG_H
+#define EVENTLOG_H
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Chegada de um agente a um vértice no tempo simulado (segundos)
+struct RegistroEvento {
+    uint32_t agente;
+    uint32_t vertice;
+    double tempo;
+};
+
+// Fila circular de um produtor e um consumidor, sem locks: o produtor só escreve a cabeça e o
+// consumidor só escreve a cauda, e cada um lê o índice do outro com acquire.
+class AnelEventos {
+public:
+    explicit AnelEventos(size_t capacidade);  // Arredondada para potência de 2
+
+    // Retorna false se a fila estiver cheia
+    bool inserir(const RegistroEvento& evento) {
+        size_t cabeca = m_cabeca.load(std::memory_order_relaxed);
+        if (cabeca - m_cauda.load(std::memory_order_acquire) > m_mascara) return false;
+        m_slots[cabeca & m_mascara] = evento;
+        m_cabeca.store(cabeca + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Copia até `maximo` eventos para destino; retorna quantos foram retirados
+    size_t retirar(RegistroEvento* destino, size_t maximo);
+
+private:
+    std::vector<RegistroEvento> m_slots;
+    size_t m_mascara;
+    alignas(64) std::atomic<size_t> m_cabeca{0};
+    alignas(64) std::atomic<size_t> m_cauda{0};
+};
+
+// Log binário da simulação. Cada thread produtora tem seu anel; uma thread escritora os esvazia
+// em blocos colunares (agentes, vértices e tempos de cada bloco contíguos). Formato do arquivo:
+//   cabeçalho: "PAAEVLOG", uint32 versão, uint32 reservado, uint64 número de eventos,
+//              uint64 posição da tabela de nomes (0 = sem nomes)
+//   blocos:    uint32 n, uint32 agente[n], uint32 vertice[n], double tempo[n]
+//   nomes:     uint32 quantidade e, para cada vértice, uint32 tamanho seguido dos caracteres
+// Os eventos ficam em ordem de tempo dentro de cada produtor, mas não entre produtores.
+class EventLog {
+public:
+    EventLog(const std::string& arquivo, int numProdutores, size_t capacidadeAnel = 1 << 16);
+    ~EventLog();
+
+    bool aberto() const { return m_aberto; }
+
+    // Nomes dos vértices, gravados no fim do arquivo para o leitor
+    void definirNomes(const std::vector<std::string>& nomes) { m_nomes = nomes; }
+
+    // Só a thread dona do `produtor` pode chamar. Com o anel cheio, espera a escritora.
+    void registrar(int produtor, uint32_t agente, uint32_t vertice, double tempo) {
+        AnelEventos& anel = *m_aneis[produtor];
+        RegistroEvento evento{agente, vertice, tempo};
+        while (!anel.inserir(evento)) std::this_thread::yield();
+    }
+
+    // Espera a escritora esvaziar os anéis e completa o arquivo. Os produtores já devem ter parado.
+    void fechar();
+
+    uint64_t getNumEventos() const { return m_numEventos; }
+
+private:
+    void escrever();
+    void gravarBloco();
+    void gravarCabecalho(uint64_t posicaoNomes);
+
+    std::ofstream m_arquivo;
+    bool m_aberto = false;
+    std::vector<std::unique_ptr<AnelEventos>> m_aneis;
+    std::vector<std::string> m_nomes;
+    std::atomic<bool> m_parar{false};
+    std::thread m_escritora;
+
+    // Bloco sendo montado pela escritora
+    std::vector<uint32_t> m_blocoAgente;
+    std::vector<uint32_t> m_blocoVertice;
+    std::vector<double> m_blocoTempo;
+    uint64_t m_numEventos = 0;
+};
+
+// Log lido de volta em colunas
+struct LogEventos {
+    std::vector<uint32_t> agente;
+    std::vector<uint32_t> vertice;
+    std::vector<double> tempo;
+    std::vector<std::string> nomes;  // Vazio se o log não tiver nomes
+};
+
+bool lerLogEventos(const std::string& arquivo, LogEventos& log);
+
+#endif // EVENTLOG_H
@@ -0,0 +1,89 @@
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include "external/json.hpp"
+#include "eventLog.h"
+
+// Converte o log binário da simulação (base_API --log) em CSV ou JSON colunar
+// ({"agente": [...], "vertice": [...], "tempo": [...]}), no formato lido pelos scripts de plot.
+// Compilação: g++ -std=c++17 -O3 eventLogReader.cpp eventLog.cpp -o eventLogReader
+// Uso: eventLogReader eventos.bin [--csv | --json] [--ordenar] [saida]
+// Sem arquivo de saída, escreve na saída padrão. --ordenar ordena os eventos pelo tempo, com empates
+// por agente e vértice, para a saída não depender de quantas threads gravaram o log.
+int main(int argc, char* argv[]) {
+    std::string entrada, saida;
+    bool json = false;
+    bool ordenar = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--csv") == 0) {
+            json = false;
+        } else if (std::strcmp(argv[i], "--json") == 0) {
+            json = true;
+        } else if (std::strcmp(argv[i], "--ordenar") == 0) {
+            ordenar = true;
+        } else if (entrada.empty()) {
+            entrada = argv[i];
+        } else if (saida.empty()) {
+            saida = argv[i];
+        } else {
+            std::cerr << "Argumento desconhecido: " << argv[i] << std::endl;
+            return 1;
+        }
+    }
+    if (entrada.empty()) {
+        std::cerr << "Uso: eventLogReader eventos.bin [--csv | --json] [--ordenar] [saida]" << std::endl;
+        return 1;
+    }
+
+    LogEventos log;
+    if (!lerLogEventos(entrada, log)) return 1;
+
+    std::vector<size_t> ordem(log.tempo.size());
+    std::iota(ordem.begin(), ordem.end(), 0);
+    if (ordenar) {
+        std::sort(ordem.begin(), ordem.end(), [&](size_t a, size_t b) {
+            if (log.tempo[a] != log.tempo[b]) return log.tempo[a] < log.tempo[b];
+            if (log.agente[a] != log.agente[b]) return log.agente[a] < log.agente[b];
+            return log.vertice[a] < log.vertice[b];
+        });
+    }
+
+    std::ofstream arquivo;
+    if (!saida.empty()) {
+        arquivo.open(saida);
+        if (!arquivo.is_open()) {
+            std::cerr << "Nao foi possivel abrir " << saida << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& out = saida.empty() ? std::cout : arquivo;
+    out.precision(12);
+
+    // Vértice pelo nome quando o log tem a tabela de nomes
+    auto nomeVertice = [&](uint32_t v) -> std::string {
+        if (v < log.nomes.size()) return log.nomes[v];
+        return std::to_string(v);
+    };
+
+    if (json) {
+        out << "{\"agente\": [";
+        for (size_t i = 0; i < ordem.size(); ++i) out << (i ? ", " : "") << log.agente[ordem[i]];
+        out << "],\n \"vertice\": [";
+        for (size_t i = 0; i < ordem.size(); ++i) {
+            uint32_t v = log.vertice[ordem[i]];
+            out << (i ? ", " : "");
+            if (log.nomes.empty()) out << v; else out << nlohmann::json(nomeVertice(v)).dump();
+        }
+        out << "],\n \"tempo\": [";
+        for (size_t i = 0; i < ordem.size(); ++i) out << (i ? ", " : "") << log.tempo[ordem[i]];
+        out << "]}\n";
+    } else {
+        out << "agente,vertice,tempo\n";
+        for (size_t i : ordem) {
+            out << log.agente[i] << ',' << nomeVertice(log.vertice[i]) << ',' << log.tempo[i] << '\n';
+        }
+    }
+    return 0;
+}
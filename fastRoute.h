@@ -4,32 +4,109 @@
 #include <vector>
 #include <string>
 #include <utility>
+#include <cstdint>
+#include <limits>
 #include "graph.h"
 
+// Modos de transporte como inteiros (índice na tabela de visitados)
+enum ModoTransporte : uint8_t {
+    MODO_WALK = 0,
+    MODO_METRO,
+    MODO_ONIBUS,
+    MODO_TAXI,
+    NUM_MODOS,
+    MODO_DESCONHECIDO = NUM_MODOS  // Arestas de outro tipo: não mudam o modo atual
+};
+
+// Máscara de modos permitidos em uma busca: bit (1 << modo) para cada ModoTransporte
+const uint8_t TODOS_OS_MODOS = (1 << NUM_MODOS) - 1;
+
+// Converte o transport_type da aresta para o modo correspondente
+ModoTransporte modoDaAresta(const std::string& transport_type);
+
 // Funções de cálculo
 double calcularTempo(const Edge& edge, const std::string& transport_type);
 double calcularCusto(const Edge& edge, const std::string& transport_type);
+double calcularTempo(const Edge& edge, ModoTransporte modo);
+double calcularCusto(const Edge& edge, ModoTransporte modo);
 
-// Estrutura do Estado
-struct Estado {
-    double tempoGasto;         
-    double dinheiroGasto;      
+// Rótulo da busca: POD de 32 bytes guardado em um pool. O caminho não é copiado a cada
+// relaxamento; cada rótulo aponta para o rótulo anterior e o caminho é montado só no final.
+struct Rotulo {
+    double tempoGasto;
+    double dinheiroGasto;
     vertex atual;
-    std::string modoAtual;
-    std::vector<vertex> caminho;
+    int32_t pai;       // Índice do rótulo anterior no pool (-1 na origem)
+    int32_t proximo;   // Próximo rótulo na sacola de Pareto do mesmo (vértice, modo) (-1 no fim)
+    uint8_t modoAtual; // ModoTransporte
+    uint8_t dominado;  // 1 se outro rótulo do mesmo estado o dominou depois de criado
+};
 
-    bool operator<(const Estado& other) const {
-        // Para a fila de prioridade funcionar como min-heap, invertemos a comparação
-        return tempoGasto > other.tempoGasto;
-    }
+// Rota da fronteira de Pareto tempo x custo
+struct RotaPareto {
+    double tempo;
+    double dinheiro;
+    std::vector<vertex> caminho;
 };
 
+// Fronteira de Pareto entre dois vértices: todas as rotas não dominadas em (tempo, dinheiro),
+// em ordem crescente de tempo e decrescente de dinheiro. Rotas acima de Kmax são descartadas.
+// Arestas de modos fora de mascaraModos não são usadas.
+std::vector<RotaPareto> fronteira_tempo_custo(
+    Graph& grafo,
+    vertex v_inicial,
+    vertex v_final,
+    double Kmax = std::numeric_limits<double>::infinity(),
+    uint8_t mascaraModos = TODOS_OS_MODOS
+);
+
+// Rota mais rápida da fronteira que cabe no orçamento K (caminho vazio se nenhuma couber)
+std::pair<std::vector<vertex>, double> melhor_da_fronteira(const std::vector<RotaPareto>& fronteira, double K);
+
 // Função principal para obter o melhor trajeto
 std::pair<std::vector<vertex>, double> obter_melhor_trajeto(
     Graph& grafo,
     vertex v_inicial,
     vertex v_final,
-    double K
+    double K,
+    uint8_t mascaraModos = TODOS_OS_MODOS
 );
 
-#endif // NEWMETRO_H
\ No newline at end of file
+class TravelProfiles;
+
+// Rota mais rápida dentro do orçamento K saindo no minuto do dia `partida`, com o tempo de cada
+// aresta multiplicado pelo seu perfil horário (arestas sem perfil usam o tempo constante).
+// O tempo devolvido é a duração da viagem em minutos.
+std::pair<std::vector<vertex>, double> obter_trajeto_no_horario(
+    Graph& grafo,
+    const TravelProfiles& perfis,
+    vertex v_inicial,
+    vertex v_final,
+    double K,
+    double partida,
+    uint8_t mascaraModos = TODOS_OS_MODOS
+);
+
+// Tempos de chegada a partir de uma origem (busca um-para-muitos)
+struct AlcanceOrigem {
+    std::vector<double> tempo;     // Minutos da rota mais rápida dentro do orçamento (infinito se não alcançado)
+    std::vector<double> dinheiro;  // Gasto dessa rota
+};
+
+// Uma única busca multicritério a partir da origem, que continua até fixar todos os alvos
+// (todos os vértices se alvos estiver vazio) ou esgotar os rótulos com tempo <= Tmax e dinheiro <= K.
+// Vértices não fixados ficam com tempo infinito.
+AlcanceOrigem tempos_de_alcance(
+    Graph& grafo,
+    vertex origem,
+    double K,
+    double Tmax = std::numeric_limits<double>::infinity(),
+    const std::vector<vertex>& alvos = {},
+    uint8_t mascaraModos = TODOS_OS_MODOS
+);
+
+// Isócronas: faixa i com os vértices alcançados em (limites[i-1], limites[i]] minutos
+// (limites em ordem crescente; a faixa 0 começa em 0)
+std::vector<std::vector<vertex>> isocronas(const AlcanceOrigem& alcance, const std::vector<double>& limites);
+
+#endif // NEWMETRO_H
@@ -1,46 +1,165 @@
-#include "newMetro.h"
-#include <queue>
+#include "fastRoute.h"
+#include "stateGraph.h"
+#include "travelProfiles.h"
+#include "paretoBags.h"
+#include "stats.h"
 #include <unordered_map>
 #include <limits>
 #include <stdexcept>
+#include <algorithm>
+#include <functional>
 
-struct Estado {
-    double tempoGasto;         
-    double dinheiroGasto;      
-    vertex atual;
-    std::string modoAtual;
-    std::vector<vertex> caminho;
+static_assert(sizeof(Rotulo) <= 32, "Rotulo deve continuar compacto");
 
-    bool operator<(const Estado& other) const {
-        // Para a fila de prioridade funcionar como min-heap, invertemos a comparação
-        return tempoGasto > other.tempoGasto;
-    }
-};
+ModoTransporte modoDaAresta(const std::string& transport_type) {
+    if (transport_type == "walk") return MODO_WALK;
+    if (transport_type == "metro") return MODO_METRO;
+    if (transport_type == "onibus") return MODO_ONIBUS;
+    if (transport_type == "taxi") return MODO_TAXI;
+    return MODO_DESCONHECIDO;
+}
 
 // Função para calcular o tempo baseado no tipo de transporte
-double calcularTempo(const Edge& edge, const std::string& transport_type) {
-    if (transport_type == "metro") {
-        return (edge.distance() / 20.0) / 60.0; // Tempo em minutos
-    } else if (transport_type == "onibus") {
-        return (edge.distance() / 12.0) / 60.0;
-    } else if (transport_type == "taxi") {
-        return (edge.distance() / 15.0) / 60.0;
-    } else if (transport_type == "walk") {
-        return (edge.distance() / 1.5) / 60.0;
+double calcularTempo(const Edge& edge, ModoTransporte modo) {
+    switch (modo) {
+        case MODO_METRO: return (edge.distance() / 20.0) / 60.0; // Tempo em minutos
+        case MODO_ONIBUS: return (edge.distance() / 12.0) / 60.0;
+        case MODO_TAXI:
+            // time_cost (segundos) acompanha o trânsito: aplicarTemposCongestionados o substitui
+            // pelo tempo congestionado da atribuição de tráfego
+            return edge.time_cost() > 0 ? edge.time_cost() / 60.0 : (edge.distance() / 15.0) / 60.0;
+        case MODO_WALK: return (edge.distance() / 1.5) / 60.0;
+        default: return std::numeric_limits<double>::max();
     }
-    return std::numeric_limits<double>::max();
 }
 
 // Função para calcular o custo baseado no tipo de transporte
+double calcularCusto(const Edge& edge, ModoTransporte modo) {
+    switch (modo) {
+        case MODO_METRO: return 4.40;
+        case MODO_ONIBUS: return 3.50;
+        case MODO_TAXI: return edge.price_cost();
+        default: return std::numeric_limits<double>::max();
+    }
+}
+
+double calcularTempo(const Edge& edge, const std::string& transport_type) {
+    return calcularTempo(edge, modoDaAresta(transport_type));
+}
+
 double calcularCusto(const Edge& edge, const std::string& transport_type) {
-    if (transport_type == "metro") {
-        return 4.40;
-    } else if (transport_type == "onibus") {
-        return 3.50;
-    } else if (transport_type == "taxi") {
-        return edge.price_cost();
+    return calcularCusto(edge, modoDaAresta(transport_type));
+}
+
+namespace {
+
+// Busca multicritério com sacolas de Pareto por (vértice, modo). Cada rótulo que chega ao destino
+// e é mais barato que todos os anteriores entra na fronteira; com apenasMaisRapida a busca para
+// na primeira chegada (a rota mais rápida dentro de Kmax). tempoArco(arco, tempoGasto) dá a duração
+// do arco saindo após tempoGasto minutos de viagem; deve respeitar FIFO para a ordem da fila valer.
+template <class TempoArco>
+std::vector<RotaPareto> buscaPareto(const StateGraph& estados, vertex v_inicial, vertex v_final, double Kmax, uint8_t mascaraModos,
+                                    bool apenasMaisRapida, const TempoArco& tempoArco) {
+    std::vector<RotaPareto> fronteira;
+    SacolasPareto busca(estados.getNumVertices());
+    std::vector<Rotulo>& rotulos = busca.rotulos;
+
+    // Menor dinheiro já registrado na fronteira: rótulos que não ficam abaixo dele são dominados
+    double menorDinheiroFronteira = std::numeric_limits<double>::infinity();
+
+    ContadoresBusca contadores;
+    ESTAT_CONTAR(contadores, buscas);
+
+    const double EPS = EPS_DINHEIRO;
+    auto inserir = [&](const Rotulo& novo) {
+        if (novo.dinheiroGasto > Kmax + EPS || novo.dinheiroGasto >= menorDinheiroFronteira - EPS) return false;
+        if (!busca.inserir(novo)) return false;
+        ESTAT_CONTAR(contadores, insercoes);
+        return true;
+    };
+
+    // Estado inicial: tempo = 0, dinheiro = 0, modo = "walk"
+    inserir(Rotulo{0.0, 0.0, v_inicial, -1, -1, MODO_WALK, 0});
+
+    while (!busca.vazia()) {
+        int32_t indiceAtual = busca.retirar();
+
+        // Cópia do rótulo: o pool pode crescer (e realocar) durante a expansão
+        const Rotulo atual = rotulos[indiceAtual];
+        if (atual.dominado || atual.dinheiroGasto >= menorDinheiroFronteira - EPS) continue;
+        ESTAT_CONTAR(contadores, assentados);
+
+        // Chegou ao destino: como os rótulos saem em ordem de tempo, ele é não dominado
+        if (atual.atual == v_final) {
+            RotaPareto rota{atual.tempoGasto, atual.dinheiroGasto, {}};
+            for (int32_t r = indiceAtual; r != -1; r = rotulos[r].pai) {
+                rota.caminho.push_back(rotulos[r].atual);
+            }
+            std::reverse(rota.caminho.begin(), rota.caminho.end());
+            // Mesmo tempo (a menos de EPS) que a última rota e mais barata: substitui a anterior
+            if (!fronteira.empty() && rota.tempo <= fronteira.back().tempo + EPS) {
+                fronteira.back() = rota;
+            } else {
+                fronteira.push_back(rota);
+            }
+            menorDinheiroFronteira = atual.dinheiroGasto;
+
+            if (apenasMaisRapida) break;
+            continue;  // Seguir adiante a partir do destino só aumentaria tempo e dinheiro
+        }
+
+        // Arcos do estado atual no grafo de estados (tarifas já aplicadas na compilação)
+        int s = StateGraph::estado(atual.atual, atual.modoAtual);
+        for (int32_t arco = estados.inicio(s); arco < estados.fim(s); ++arco) {
+            if (!estados.permitido(arco, mascaraModos)) continue;
+            ESTAT_CONTAR(contadores, relaxadas);
+            int destino = estados.destino(arco);
+            inserir(Rotulo{atual.tempoGasto + tempoArco(arco, atual.tempoGasto), atual.dinheiroGasto + estados.custo(arco),
+                           StateGraph::verticeDe(destino), indiceAtual, -1, StateGraph::modoDe(destino), 0});
+        }
     }
-    return std::numeric_limits<double>::max();
+
+    ESTAT_PICO_BYTES(contadores, busca.bytes());
+    ESTAT_REGISTRAR_BUSCA("rota_pareto", contadores);
+    return fronteira;
+}
+
+// Tempos estáticos do grafo de estados
+struct TempoEstatico {
+    const StateGraph& estados;
+    double operator()(int32_t arco, double) const { return estados.tempo(arco); }
+};
+
+// Tempo estático multiplicado pelo fator do perfil da aresta no horário de saída do arco
+struct TempoNoHorario {
+    const StateGraph& estados;
+    const TravelProfiles& perfis;
+    double partida;
+    double operator()(int32_t arco, double tempoGasto) const {
+        double base = estados.tempo(arco);
+        return base == 0.0 ? 0.0 : base * perfis.fatorAresta(estados.arestaId(arco), partida + tempoGasto);
+    }
+};
+
+std::vector<RotaPareto> buscaEstatica(Graph& grafo, vertex v_inicial, vertex v_final, double Kmax, uint8_t mascaraModos, bool apenasMaisRapida) {
+    std::shared_ptr<const StateGraph> estados = StateGraph::compilado(grafo);
+    return buscaPareto(*estados, v_inicial, v_final, Kmax, mascaraModos, apenasMaisRapida, TempoEstatico{*estados});
+}
+
+} // namespace
+
+std::vector<RotaPareto> fronteira_tempo_custo(Graph& grafo, vertex v_inicial, vertex v_final, double Kmax, uint8_t mascaraModos) {
+    return buscaEstatica(grafo, v_inicial, v_final, Kmax, mascaraModos, false);
+}
+
+std::pair<std::vector<vertex>, double> melhor_da_fronteira(const std::vector<RotaPareto>& fronteira, double K) {
+    // A fronteira está em ordem crescente de tempo: a primeira rota que cabe no orçamento é a melhor
+    for (const RotaPareto& rota : fronteira) {
+        if (rota.dinheiro <= K + EPS_DINHEIRO) {
+            return {rota.caminho, rota.tempo};
+        }
+    }
+    return {std::vector<vertex>(), 0};
 }
 
 // Função para obter o melhor trajeto
@@ -48,135 +167,103 @@ std::pair<std::vector<vertex>, double> obter_melhor_trajeto(
     Graph& grafo,
     vertex v_inicial,
     vertex v_final,
-    double K
+    double K,
+    uint8_t mascaraModos
 ) {
-    // Fila de prioridade: min-heap baseado no tempo gasto
-    std::priority_queue<Estado> fila;
+    // Mesma busca da fronteira, parando na rota mais rápida dentro do orçamento
+    return melhor_da_fronteira(buscaEstatica(grafo, v_inicial, v_final, K, mascaraModos, true), K);
+}
 
-    // Estado inicial: tempo = 0, dinheiro = 0, modo = "walk"
-    fila.push(Estado{0.0, 0.0, v_inicial, "walk", {v_inicial}});
+std::pair<std::vector<vertex>, double> obter_trajeto_no_horario(
+    Graph& grafo,
+    const TravelProfiles& perfis,
+    vertex v_inicial,
+    vertex v_final,
+    double K,
+    double partida,
+    uint8_t mascaraModos
+) {
+    std::shared_ptr<const StateGraph> estados = StateGraph::compilado(grafo);
+    return melhor_da_fronteira(
+        buscaPareto(*estados, v_inicial, v_final, K, mascaraModos, true, TempoNoHorario{*estados, perfis, partida}), K);
+}
 
-    // Mapa para armazenar os estados visitados: (vértice, modo) -> tempo mínimo gasto
-    std::unordered_map<std::string, std::pair<double, double>> visitados;
+AlcanceOrigem tempos_de_alcance(
+    Graph& grafo,
+    vertex origem,
+    double K,
+    double Tmax,
+    const std::vector<vertex>& alvos,
+    uint8_t mascaraModos
+) {
+    std::shared_ptr<const StateGraph> compilado = StateGraph::compilado(grafo);
+    const StateGraph& estados = *compilado;
+    int n = estados.getNumVertices();
+    AlcanceOrigem alcance;
+    alcance.tempo.assign(n, std::numeric_limits<double>::infinity());
+    alcance.dinheiro.assign(n, std::numeric_limits<double>::infinity());
+    if (origem < 0 || origem >= n) return alcance;
 
-    // Variáveis para armazenar o melhor caminho e o menor tempo
-    double melhorTempo = 0;
-    std::vector<vertex> melhorCaminho;
+    // Sem alvos, todos os vértices são alvos
+    std::vector<char> ehAlvo(n, alvos.empty() ? 1 : 0);
+    for (vertex v : alvos) {
+        if (v >= 0 && v < n) ehAlvo[v] = 1;
+    }
+    int restantes = 0;
+    for (char a : ehAlvo) restantes += a;
 
-    while (!fila.empty()) {
-        Estado atualEstado = fila.top();
-        fila.pop();
+    SacolasPareto busca(n);
+    ContadoresBusca contadores;
+    ESTAT_CONTAR(contadores, buscas);
+    const double EPS = EPS_DINHEIRO;
+    auto inserir = [&](const Rotulo& novo) {
+        if (novo.dinheiroGasto > K + EPS || novo.tempoGasto > Tmax) return false;
+        if (!busca.inserir(novo)) return false;
+        ESTAT_CONTAR(contadores, insercoes);
+        return true;
+    };
 
-        vertex verticeAtual = atualEstado.atual;
-        double tempoAtual = atualEstado.tempoGasto;
-        double dinheiroAtual = atualEstado.dinheiroGasto;
-        std::string modoAtual = atualEstado.modoAtual;
-        std::vector<vertex> caminhoAtual = atualEstado.caminho;
+    inserir(Rotulo{0.0, 0.0, origem, -1, -1, MODO_WALK, 0});
 
-        // Verifica se chegou ao destino
-        if (verticeAtual == v_final) {
-            return {caminhoAtual, tempoAtual};
-        }
+    // Não há destino para podar a busca: rótulos mais lentos porém mais baratos continuam sendo
+    // expandidos depois que o vértice é fixado, pois podem alcançar outros vértices dentro de K
+    while (!busca.vazia() && restantes > 0) {
+        int32_t indiceAtual = busca.retirar();
 
-        // Se chegou ao destino, atualiza o melhor tempo e caminho
-        if (verticeAtual == v_final) {
-            if (tempoAtual < melhorTempo) {
-                melhorTempo = tempoAtual;
-                melhorCaminho = caminhoAtual;
-            }
-        }
+        const Rotulo atual = busca.rotulos[indiceAtual];
+        if (atual.dominado) continue;
+        ESTAT_CONTAR(contadores, assentados);
 
-        // Chave para o mapa de visitados
-        std::string chave = std::to_string(verticeAtual) + "_" + modoAtual;
+        // Os rótulos saem em ordem de tempo: a primeira chegada a um vértice é a mais rápida
+        if (alcance.tempo[atual.atual] == std::numeric_limits<double>::infinity()) {
+            alcance.tempo[atual.atual] = atual.tempoGasto;
+            alcance.dinheiro[atual.atual] = atual.dinheiroGasto;
+            if (ehAlvo[atual.atual]) restantes--;
+        }
 
-        // Verifica se já visitou este estado com menos tempo   
-        if (visitados.find(chave) != visitados.end()) {
-            auto [tempoVisitado, custoVisitado] = visitados[chave];
-            if (tempoVisitado <= tempoAtual && custoVisitado <= dinheiroAtual) {
-                continue;  
-            }
+        int s = StateGraph::estado(atual.atual, atual.modoAtual);
+        for (int32_t arco = estados.inicio(s); arco < estados.fim(s); ++arco) {
+            if (!estados.permitido(arco, mascaraModos)) continue;
+            ESTAT_CONTAR(contadores, relaxadas);
+            int destino = estados.destino(arco);
+            inserir(Rotulo{atual.tempoGasto + estados.tempo(arco), atual.dinheiroGasto + estados.custo(arco),
+                           StateGraph::verticeDe(destino), indiceAtual, -1, StateGraph::modoDe(destino), 0});
         }
+    }
 
-        // Marca como visitado
-        visitados[chave] = {tempoAtual, dinheiroAtual};
-
-        // Itera sobre as arestas do vértice atual
-        Edge* edge = grafo.getEdges(verticeAtual);
-        while (edge) {
-            vertex vizinho = edge->otherVertex(verticeAtual);
-            std::string tipoTransporte = edge->transport_type();
-            double tempoAresta = 0.0;
-            double custoAresta = 0.0;
-            std::string novoModo = modoAtual;
-            double novoDinheiro = dinheiroAtual;
-            double novoTempo = tempoAtual;
-            std::vector<vertex> novoCaminho = caminhoAtual;
-            novoCaminho.push_back(vizinho);
-
-            // Se a aresta for uma linha de metrô
-            if (tipoTransporte == "metro") {
-                if (modoAtual != "metro") { // Se for entrar no metrô agora
-                    custoAresta = calcularCusto(*edge, "metro");  // Cobre o ticket de metrô
-                    tempoAresta = calcularTempo(*edge, "metro");
-                }
-                // Se já estiver no metrô, apenas adiciona o tempo
-                else {
-                    tempoAresta = calcularTempo(*edge, "metro");
-                }
-                novoModo = "metro";
-            }
-            // Mesma lógica para o ônibus
-            else if (tipoTransporte == "onibus") {
-                if (modoAtual != "onibus") {
-                    custoAresta = calcularCusto(*edge, "onibus"); // Custo do ticket de ônibus
-                    tempoAresta = calcularTempo(*edge, "onibus");
-                }
-                // Se já estiver no ônibus, apenas adiciona o tempo
-                else {
-                    tempoAresta = calcularTempo(*edge, "onibus");
-                }
-                novoModo = "onibus";
-            }
-            // Se a aresta for uma linha de taxi 
-            else if (tipoTransporte == "taxi") {
-                custoAresta = calcularCusto(*edge, "taxi");
-                tempoAresta = calcularTempo(*edge, "taxi");
-                novoModo = "taxi";
-                // Se a pessoa já estiver no taxi, o custo fixo deve ser descontado
-                if (modoAtual != "taxi") {
-                    custoAresta += 10.0;
-                }
-            }
-            // Se a aresta for caminhar
-            else if (tipoTransporte == "walk") {
-                tempoAresta = calcularTempo(*edge, "walk");
-                novoModo = "walk";
-            }    
-
-            // Atualiza o tempo e o dinheiro
-            novoTempo += tempoAresta;
-            novoDinheiro += custoAresta;
-
-            // Verifica se o custo está dentro do limite
-            if (novoDinheiro > K) {
-                // Não considera este caminho
-                edge = edge->next();
-                continue;
-            }
+    ESTAT_PICO_BYTES(contadores, busca.bytes());
+    ESTAT_REGISTRAR_BUSCA("alcance_pareto", contadores);
+    return alcance;
+}
 
-            // Adiciona o novo estado à fila
-            fila.push(Estado{
-                novoTempo,
-                novoDinheiro,
-                vizinho,
-                novoModo,
-                novoCaminho
-            });
-
-            // Próxima aresta
-            edge = edge->next();
+std::vector<std::vector<vertex>> isocronas(const AlcanceOrigem& alcance, const std::vector<double>& limites) {
+    std::vector<std::vector<vertex>> faixas(limites.size());
+    for (vertex v = 0; v < (vertex)alcance.tempo.size(); ++v) {
+        // Primeira faixa cujo limite cobre o tempo de chegada (limites em ordem crescente)
+        auto it = std::lower_bound(limites.begin(), limites.end(), alcance.tempo[v]);
+        if (it != limites.end()) {
+            faixas[it - limites.begin()].push_back(v);
         }
     }
-
-    return {melhorCaminho, melhorTempo};
-}
\ No newline at end of file
+    return faixas;
+}
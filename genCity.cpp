@@ -0,0 +1,50 @@
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include "cityGenerator.h"
+
+// Gera uma cidade sintética no modelo de main.py e grava no formato de city_graph.json (compacto).
+// Compilação: g++ -std=c++17 -O3 genCity.cpp cityGenerator.cpp Graph.cpp -o genCity
+// Uso: genCity saida.json [--linhas N] [--colunas M] [--semente S] [--pular P] [--imoveis]
+int main(int argc, char* argv[]) {
+    ParametrosCidade parametros;
+    std::string arquivoSaida;
+    bool imoveis = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--linhas") == 0 && i + 1 < argc) {
+            parametros.linhas = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--colunas") == 0 && i + 1 < argc) {
+            parametros.colunas = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--semente") == 0 && i + 1 < argc) {
+            parametros.semente = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--pular") == 0 && i + 1 < argc) {
+            parametros.probabilidadePular = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--imoveis") == 0) {
+            imoveis = true;
+        } else if (arquivoSaida.empty() && argv[i][0] != '-') {
+            arquivoSaida = argv[i];
+        } else {
+            std::cerr << "Argumento desconhecido: " << argv[i] << std::endl;
+            return 1;
+        }
+    }
+    if (arquivoSaida.empty() || parametros.linhas <= 0 || parametros.colunas <= 0) {
+        std::cerr << "Uso: " << argv[0] << " saida.json [--linhas N] [--colunas M] [--semente S] [--pular P] [--imoveis]" << std::endl;
+        return 1;
+    }
+
+    auto inicio = std::chrono::steady_clock::now();
+    CidadeGerada cidade(parametros);
+    auto gerado = std::chrono::steady_clock::now();
+    if (!cidade.gravarJSON(arquivoSaida, imoveis)) {
+        return 1;
+    }
+    auto gravado = std::chrono::steady_clock::now();
+
+    auto segundos = [](auto a, auto b) { return std::chrono::duration<double>(b - a).count(); };
+    std::cout << "Cruzamentos: " << cidade.getNumVertices() << std::endl;
+    std::cout << "Ruas: " << cidade.ruas().size() << " (" << cidade.ruas().size() * 4 << " arestas no JSON)" << std::endl;
+    std::cout << "Geracao: " << segundos(inicio, gerado) << " s, gravacao: " << segundos(gerado, gravado) << " s" << std::endl;
+    return 0;
+}
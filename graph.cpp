@@ -1,12 +1,18 @@
 #include "Graph.h"
+#include <atomic>
 #include <fstream>
 #include <iostream>
 #include "external/json.hpp"
+#include "memoryReport.h"
 
 using json = nlohmann::json;
 
+namespace {
+std::atomic<unsigned long long> proximoIdGrafo{1};
+}
+
 Graph::Graph(int numVertices)
-    : m_numVertices(numVertices), m_numEdges(0), m_nodeIds(numVertices, "") {
+    : m_numVertices(numVertices), m_numEdges(0), m_nodeIds(numVertices, ""), m_id(proximoIdGrafo++) {
         for(vertex v = 0; v < numVertices; ++v){
             m_edges[v] = nullptr;  // Initialize each vertex with no edges
         }
@@ -28,12 +34,29 @@ void Graph::addEdge(vertex v1, vertex v2, double cost, int distance, const std::
     if (!hasEdge(v1, v2, transport_type)) {
         // Cria uma nova aresta com todos os atributos e adiciona à lista encadeada de arestas do vértice v1
         Edge* newEdge = new Edge(v1, v2, cost, distance, transport_type, max_speed, price_cost, time_cost, num_residencial, num_commercial, num_touristic, num_industrial, bus_preference, m_edges[v1]);
+        newEdge->setId(m_edgeById.size());
+        m_edgeById.push_back(newEdge);
+        m_colResidencial.push_back(num_residencial);
+        m_colCommercial.push_back(num_commercial);
+        m_colTouristic.push_back(num_touristic);
+        m_colIndustrial.push_back(num_industrial);
         m_edges[v1] = newEdge;
         m_numEdges++;
+        m_version++;
     }
 }
 
 
+bool Graph::setEdgeTimeCost(int id, double time_cost) {
+    Edge* edge = getEdgeById(id);
+    if (!edge) {
+        return false;
+    }
+    edge->setTimeCost(time_cost);
+    m_version++;
+    return true;
+}
+
 void Graph::removeEdge(vertex v1, vertex v2, const std::string& transport_type) {
     Edge* edge = m_edges[v1];
     Edge* prevEdge = nullptr;
@@ -45,8 +68,14 @@ void Graph::removeEdge(vertex v1, vertex v2, const std::string& transport_type)
             } else {
                 m_edges[v1] = edge->next();  // Remove da lista de v1
             }
+            m_edgeById[edge->id()] = nullptr;  // O id não é reaproveitado
+            m_colResidencial[edge->id()] = 0;
+            m_colCommercial[edge->id()] = 0;
+            m_colTouristic[edge->id()] = 0;
+            m_colIndustrial[edge->id()] = 0;
             delete edge;  // Libera a memória da aresta
             m_numEdges--;  // Atualiza o contador de arestas
+            m_version++;
             break;  // Sai do loop após remover a aresta
         }
         prevEdge = edge;
@@ -68,6 +97,47 @@ bool Graph::hasEdge(vertex v1, vertex v2, const std::string& transport_type) {
 }
 
 
+const std::vector<double>& Graph::busWeights(const BusWeightCoefficients& coef) const {
+    if (m_busWeightsVersion == m_version && m_busWeightsCoef == coef) {
+        return m_busWeights;
+    }
+
+    // Passada única sobre as colunas contíguas; sem dependências entre iterações, o laço é vetorizado pelo compilador
+    size_t numEdges = m_edgeById.size();
+    m_busWeights.resize(numEdges);
+    const int* __restrict residencial = m_colResidencial.data();
+    const int* __restrict commercial = m_colCommercial.data();
+    const int* __restrict touristic = m_colTouristic.data();
+    const int* __restrict industrial = m_colIndustrial.data();
+    double* __restrict weights = m_busWeights.data();
+    const double cc = coef.commercial, ct = coef.touristic, cr = coef.residencial, ci = coef.industrial;
+    for (size_t i = 0; i < numEdges; ++i) {
+        weights[i] = commercial[i] * cc + touristic[i] * ct + residencial[i] * cr + industrial[i] * ci;
+    }
+
+    m_busWeightsVersion = m_version;
+    m_busWeightsCoef = coef;
+    return m_busWeights;
+}
+
+MemoriaGrafo Graph::memoria() const {
+    MemoriaGrafo memoria;
+    memoria.adjacencia = bytesMapaHash(m_edges) + bytesVetor(m_edgeById);
+    for (Edge* edge : m_edgeById) {
+        if (!edge) continue;
+        memoria.adjacencia += bytesAlocacao(sizeof(Edge));
+        memoria.atributos += bytesString(edge->transport_type());
+    }
+    memoria.atributos += bytesVetor(m_colResidencial) + bytesVetor(m_colCommercial) + bytesVetor(m_colTouristic) +
+                         bytesVetor(m_colIndustrial) + bytesVetor(m_busWeights);
+    memoria.ids = bytesVetor(m_nodeIds);
+    for (const std::string& id : m_nodeIds) memoria.ids += bytesString(id);
+    memoria.indices = bytesMapaHash(m_vertexOf) + bytesMapaHash(m_regionMap);
+    for (const auto& par : m_vertexOf) memoria.indices += bytesString(par.first);
+    for (const auto& par : m_regionMap) memoria.indices += bytesString(par.first);
+    return memoria;
+}
+
 void Graph::print() const {
     for (const auto& pair : m_edges) {
         vertex v1 = pair.first;
@@ -80,21 +150,35 @@ void Graph::print() const {
     }
 }
 
-void Graph::loadFromJSON(const std::string& filename) {
+bool Graph::loadFromJSON(const std::string& filename) {
     // Open the JSON file and parse it
     std::ifstream file(filename);
-    json graphData;
-    file >> graphData;
+    if (!file.is_open()) {
+        std::cerr << "Failed to open " << filename << std::endl;
+        return false;
+    }
+    json graphData = json::parse(file, nullptr, false);
+    if (graphData.is_discarded() || !graphData.contains("nodes") || !graphData.contains("edges")) {
+        std::cerr << "Invalid graph JSON: " << filename << std::endl;
+        return false;
+    }
 
     // Load nodes and edges
     auto nodes = graphData["nodes"];
     auto edges = graphData["edges"];
+    if ((int)nodes.size() > m_numVertices) {
+        std::cerr << "Graph has " << m_numVertices << " vertices but " << filename << " has " << nodes.size() << " nodes" << std::endl;
+        return false;
+    }
 
-    // Map node ids to integer indices
+    // Map node ids to integer indices, storing the node ID and region of each vertex
     std::unordered_map<std::string, vertex> nodeMap;
     vertex nodeId = 0;
     for (const auto& node : nodes) {
-        nodeMap[node["id"]] = nodeId++;
+        std::string nodeIdStr = node["id"];
+        setNodeId(nodeId, nodeIdStr);
+        setRegion(nodeIdStr, node["region"]);
+        nodeMap[nodeIdStr] = nodeId++;
     }
 
     // Adiciona arestas ao grafo
@@ -113,12 +197,12 @@ void Graph::loadFromJSON(const std::string& filename) {
         int num_industrial = edge["num_industrial"];
         int bus_preference = edge["bus_preference"];
         int distance = edge["distance"];
-        double cost = edge["price_cost"];  // Usando 'price_cost' como custo para Kruskal
+        int cost = edge["excavation_cost"];  // Custo de escavação, usado pelo Kruskal do metrô
 
         // Adiciona a aresta ao grafo em ambas as direções (grafo não direcionado)
         addEdge(v1, v2, cost, distance, transport_type, max_speed, price_cost, time_cost, num_residencial, num_commercial, num_touristic, num_industrial, bus_preference);
         addEdge(v2, v1, cost, distance, transport_type, max_speed, price_cost, time_cost, num_residencial, num_commercial, num_touristic, num_industrial, bus_preference);
     }
-
+    return true;
 }
 
@@ -14,6 +14,29 @@ typedef int vertex;  // Define vertex type as int
 // Forward declaration of the Edge class
 class Edge;
 
+// Coeficientes do peso de ônibus de uma rua por tipo de edifício (peso menor = rua preferida)
+struct BusWeightCoefficients {
+    double commercial = -2.0;
+    double touristic = -3.0;
+    double residencial = 1.5;
+    double industrial = 1.0;
+
+    bool operator==(const BusWeightCoefficients& other) const {
+        return commercial == other.commercial && touristic == other.touristic &&
+               residencial == other.residencial && industrial == other.industrial;
+    }
+};
+
+// Memória ocupada por um Graph, em bytes (estimativa com o cabeçalho de cada alocação do malloc)
+struct MemoriaGrafo {
+    size_t adjacencia = 0;  // Objetos Edge, listas por vértice e índice de arestas por id
+    size_t atributos = 0;   // Colunas de edifícios, cache de pesos de ônibus e strings de transporte
+    size_t ids = 0;         // Strings dos node IDs
+    size_t indices = 0;     // Mapas node ID -> vértice e node ID -> região
+
+    size_t total() const { return adjacencia + atributos + ids + indices; }
+};
+
 class Graph {
 public:
     Graph(int numVertices);
@@ -25,7 +48,8 @@ public:
     void removeEdge(vertex v1, vertex v2, const std::string& transport_type);
     bool hasEdge(vertex v1, vertex v2, const std::string& transport_type);
     void print() const;
-    void loadFromJSON(const std::string& filename);  // Function to load graph from a JSON file
+    // Carrega nós (ids e regiões) e arestas de um JSON da cidade; false se o arquivo for inválido
+    bool loadFromJSON(const std::string& filename);
 
     // New functions for region management
     void setRegion(const std::string& nodeId, int region) {
@@ -44,9 +68,19 @@ public:
     void setNodeId(vertex v, const std::string& nodeId) {
         if (v >= 0 && v < m_nodeIds.size()) {
             m_nodeIds[v] = nodeId;
+            m_vertexOf[nodeId] = v;
         }
     }
 
+    // Vértice correspondente a um node ID (-1 se não existir)
+    vertex getVertex(const std::string& nodeId) const {
+        auto it = m_vertexOf.find(nodeId);
+        if (it != m_vertexOf.end()) {
+            return it->second;
+        }
+        return -1;
+    }
+
     std::string getNodeId(vertex v) const {
         if (v >= 0 && v < m_nodeIds.size()) {
             return m_nodeIds[v];
@@ -57,12 +91,60 @@ public:
     int getNumVertices() const { return m_numVertices; }
     Edge* getEdges(vertex v) const { return m_edges.at(v); }
 
+    // Ids de aresta: estáveis enquanto a aresta existir (nullptr depois de removida)
+    Edge* getEdgeById(int id) const {
+        if (id >= 0 && id < (int)m_edgeById.size()) {
+            return m_edgeById[id];
+        }
+        return nullptr;
+    }
+    int getNumEdgeIds() const { return m_edgeById.size(); }
+
+    // Troca o time_cost de uma aresta (ex.: tempos congestionados da atribuição de tráfego).
+    // Conta como mudança do grafo: a versão é incrementada e os caches são invalidados.
+    bool setEdgeTimeCost(int id, double time_cost);
+
+    // Versão do grafo: incrementada a cada addEdge/removeEdge/setEdgeTimeCost, usada para invalidar caches
+    unsigned long long getVersion() const { return m_version; }
+
+    // Identificador único do grafo no processo (nunca reaproveitado, ao contrário do endereço):
+    // junto com a versão, é a chave dos caches
+    unsigned long long getId() const { return m_id; }
+
+    // Contagens de edifícios em colunas (SoA) indexadas pelo id da aresta
+    const std::vector<int>& residencialColumn() const { return m_colResidencial; }
+    const std::vector<int>& commercialColumn() const { return m_colCommercial; }
+    const std::vector<int>& touristicColumn() const { return m_colTouristic; }
+    const std::vector<int>& industrialColumn() const { return m_colIndustrial; }
+
+    // Peso de ônibus de todas as arestas (indexado pelo id), calculado em uma passada sobre as
+    // colunas e guardado até o grafo mudar ou os coeficientes serem outros
+    const std::vector<double>& busWeights(const BusWeightCoefficients& coef = BusWeightCoefficients()) const;
+
+    // Bytes ocupados por componente (ver memoryReport.h)
+    MemoriaGrafo memoria() const;
+
 private:
     std::unordered_map<std::string, int> m_regionMap;  // Map node IDs to region IDs
     std::vector<std::string> m_nodeIds;  // Vector to store node IDs corresponding to vertices
+    std::unordered_map<std::string, vertex> m_vertexOf;  // Node ID -> vertex
     int m_numVertices;
     int m_numEdges;
     std::unordered_map<vertex, Edge*> m_edges;
+    std::vector<Edge*> m_edgeById;  // Indexa as arestas pelo id atribuído em addEdge
+    unsigned long long m_version = 0;
+    unsigned long long m_id;
+
+    // Colunas de edifícios por id de aresta (zeradas quando a aresta é removida)
+    std::vector<int> m_colResidencial;
+    std::vector<int> m_colCommercial;
+    std::vector<int> m_colTouristic;
+    std::vector<int> m_colIndustrial;
+
+    // Cache dos pesos de ônibus
+    mutable std::vector<double> m_busWeights;
+    mutable unsigned long long m_busWeightsVersion = ~0ULL;
+    mutable BusWeightCoefficients m_busWeightsCoef;
 };
 
 
@@ -77,7 +159,7 @@ public:
           m_num_residencial(num_residencial),
           m_num_commercial(num_commercial), m_num_touristic(num_touristic),
           m_num_industrial(num_industrial), m_bus_preference(bus_preference),
-          m_next(nullptr) {}
+          m_next(nullptr), m_id(-1) {}
 
     // Construtor com o ponteiro para a próxima aresta (para construir a lista encadeada)
     Edge(vertex v1, vertex v2, double cost, int distance, const std::string& transport_type, double max_speed, double price_cost, double time_cost, int num_residencial, int num_commercial, int num_touristic, int num_industrial, int bus_preference, Edge* next)
@@ -87,7 +169,7 @@ public:
           m_num_residencial(num_residencial),
           m_num_commercial(num_commercial), m_num_touristic(num_touristic),
           m_num_industrial(num_industrial), m_bus_preference(bus_preference),
-          m_next(next) {}
+          m_next(next), m_id(-1) {}
 
     // Getters para os atributos
     vertex v1() const { return m_v1; }
@@ -98,6 +180,7 @@ public:
     double max_speed() const { return m_max_speed; }
     double price_cost() const { return m_price_cost; }
     double time_cost() const { return m_time_cost; }
+    void setTimeCost(double time_cost) { m_time_cost = time_cost; }
     int num_residencial() const { return m_num_residencial; }
     int num_commercial() const { return m_num_commercial; }
     int num_touristic() const { return m_num_touristic; }
@@ -108,6 +191,10 @@ public:
     Edge* next() const { return m_next; }
     void setNext(Edge* next) { m_next = next; }
 
+    // Id da aresta no grafo (-1 se a aresta não pertence a um Graph)
+    int id() const { return m_id; }
+    void setId(int id) { m_id = id; }
+
     // Get the other vertex (v1 or v2)
     vertex otherVertex(vertex v) const {
         return (v == m_v1) ? m_v2 : m_v1;
@@ -128,6 +215,7 @@ private:
     int m_num_industrial;           // Número de áreas industriais
     int m_bus_preference;           // Preferência de ônibus
     Edge* m_next;                   // Próxima aresta na lista encadeada
+    int m_id;                       // Id da aresta no grafo
 };
 
 
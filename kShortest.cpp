@@ -0,0 +1,357 @@
+#include "kShortest.h"
+#include "stateGraph.h"
+#include "paretoBags.h"
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <map>
+#include <queue>
+#include <set>
+
+namespace {
+
+const double INF = std::numeric_limits<double>::infinity();
+
+// Caminho no grafo da busca: nós são vértices (distância) ou estados vértice * NUM_MODOS + modo
+// (multimodal), com custo e dinheiro acumulados até cada nó
+struct CaminhoYen {
+    std::vector<int32_t> nos;
+    std::vector<double> custo;
+    std::vector<double> dinheiro;
+};
+
+// Dijkstra a partir do destino pelas arestas invertidas: limite inferior do custo restante
+// de cada vértice (reverso[v] = arcos que chegam a v, como (origem, custo))
+std::vector<double> custoAteODestino(const std::vector<std::vector<std::pair<vertex, double>>>& reverso, vertex destino) {
+    std::vector<double> custo(reverso.size(), INF);
+    typedef std::pair<double, vertex> Item;
+    std::priority_queue<Item, std::vector<Item>, std::greater<Item>> fila;
+    custo[destino] = 0;
+    fila.push({0.0, destino});
+    while (!fila.empty()) {
+        auto [c, v] = fila.top();
+        fila.pop();
+        if (c > custo[v]) continue;
+        for (const auto& [u, peso] : reverso[v]) {
+            if (c + peso < custo[u]) {
+                custo[u] = c + peso;
+                fila.push({custo[u], u});
+            }
+        }
+    }
+    return custo;
+}
+
+// Yen genérico sobre uma Busca que oferece:
+//   vertex vertice(int32_t no)      -- vértice do nó
+//   double estimativa(int32_t no)   -- limite inferior consistente do custo até o destino
+//   bool desviar(raiz, i, proibidos, limite, saida) -- melhor caminho de raiz.nos[i] ao destino,
+//        partindo dos acumulados de raiz em i, sem passar pelos vértices de raiz.nos[0..i), sem ir
+//        do primeiro nó direto para um dos vértices proibidos (em qualquer modo) e com custo final
+//        menor que limite
+// Rotas com a mesma sequência de vértices contam uma vez só (fica a mais barata encontrada). Raízes
+// e continuações proibidas também são comparadas por vértice: um desvio que só troca o modo de um
+// trecho já usado daria uma rota repetida e esconderia a próxima alternativa de verdade.
+template <class Busca>
+std::vector<CaminhoYen> yen(Busca& busca, int32_t inicio, int k) {
+    std::vector<CaminhoYen> aceitos;
+    CaminhoYen raizInicial{{inicio}, {0.0}, {0.0}};
+    CaminhoYen primeiro;
+    if (k <= 0 || !busca.desviar(raizInicial, 0, {}, INF, primeiro)) return aceitos;
+
+    auto verticesDe = [&busca](const CaminhoYen& caminho) {
+        std::vector<vertex> vertices;
+        vertices.reserve(caminho.nos.size());
+        for (int32_t no : caminho.nos) vertices.push_back(busca.vertice(no));
+        return vertices;
+    };
+
+    // Candidatos por custo e, para cada sequência de vértices pendente, o seu candidato
+    typedef std::multimap<double, std::pair<std::vector<vertex>, CaminhoYen>> Candidatos;
+    Candidatos candidatos;
+    std::map<std::vector<vertex>, Candidatos::iterator> pendentes;
+    std::set<std::vector<vertex>> aceitosVertices{verticesDe(primeiro)};
+    std::vector<int32_t> proibidos;
+    aceitos.push_back(std::move(primeiro));
+
+    while ((int)aceitos.size() < k) {
+        const size_t faltam = k - aceitos.size();
+        const CaminhoYen anterior = aceitos.back();
+
+        // Desvios do fim para o começo: os mais próximos do destino tendem a ser baratos e
+        // apertam o limite cedo para os desvios seguintes
+        for (size_t i = anterior.nos.size() - 1; i-- > 0;) {
+            // Poda: só interessam desvios mais baratos que o pior candidato ainda útil; se nem a
+            // melhor continuação a partir de i fica abaixo dele, o desvio nem é buscado
+            double limite = INF;
+            if (candidatos.size() >= faltam) {
+                limite = std::next(candidatos.begin(), faltam - 1)->first;
+                if (anterior.custo[i] + busca.estimativa(anterior.nos[i]) >= limite) continue;
+            }
+
+            // Vértices seguintes já usados por rotas aceitas com a mesma raiz de vértices
+            proibidos.clear();
+            for (const CaminhoYen& aceito : aceitos) {
+                if (aceito.nos.size() > i + 1 &&
+                    std::equal(aceito.nos.begin(), aceito.nos.begin() + i + 1, anterior.nos.begin(),
+                               [&busca](int32_t a, int32_t b) { return busca.vertice(a) == busca.vertice(b); })) {
+                    proibidos.push_back(busca.vertice(aceito.nos[i + 1]));
+                }
+            }
+
+            CaminhoYen desvio;
+            if (!busca.desviar(anterior, i, proibidos, limite, desvio)) continue;
+
+            // Raiz (nós antes de i) seguida do desvio (que começa em i)
+            CaminhoYen candidato;
+            candidato.nos.assign(anterior.nos.begin(), anterior.nos.begin() + i);
+            candidato.custo.assign(anterior.custo.begin(), anterior.custo.begin() + i);
+            candidato.dinheiro.assign(anterior.dinheiro.begin(), anterior.dinheiro.begin() + i);
+            candidato.nos.insert(candidato.nos.end(), desvio.nos.begin(), desvio.nos.end());
+            candidato.custo.insert(candidato.custo.end(), desvio.custo.begin(), desvio.custo.end());
+            candidato.dinheiro.insert(candidato.dinheiro.end(), desvio.dinheiro.begin(), desvio.dinheiro.end());
+
+            // Descarta caminhos que repetem vértice (possível quando o nó é um estado) e repetidos
+            std::vector<vertex> vertices = verticesDe(candidato);
+            std::vector<vertex> ordenados = vertices;
+            std::sort(ordenados.begin(), ordenados.end());
+            if (std::adjacent_find(ordenados.begin(), ordenados.end()) != ordenados.end()) continue;
+            if (aceitosVertices.count(vertices)) continue;
+
+            // Mesma sequência já pendente: fica a mais barata
+            double custoFinal = candidato.custo.back();
+            auto pendente = pendentes.find(vertices);
+            if (pendente != pendentes.end()) {
+                if (pendente->second->first <= custoFinal) continue;
+                candidatos.erase(pendente->second);
+                pendentes.erase(pendente);
+            }
+            pendentes[vertices] = candidatos.emplace(custoFinal, std::make_pair(vertices, std::move(candidato)));
+
+            // Só os `faltam` melhores candidatos ainda podem ser aceitos
+            if (candidatos.size() > faltam) {
+                auto ultimo = std::prev(candidatos.end());
+                pendentes.erase(ultimo->second.first);
+                candidatos.erase(ultimo);
+            }
+        }
+
+        if (candidatos.empty()) break;
+        auto melhor = candidatos.begin();
+        pendentes.erase(melhor->second.first);
+        aceitosVertices.insert(melhor->second.first);
+        aceitos.push_back(std::move(melhor->second.second));
+        candidatos.erase(melhor);
+    }
+    return aceitos;
+}
+
+// Desvios por distância: A* em um CSR com a menor distância entre arestas paralelas
+class BuscaDistancia {
+public:
+    BuscaDistancia(const Graph& graph, vertex destino) : m_destino(destino) {
+        int n = graph.getNumVertices();
+        std::vector<std::vector<std::pair<vertex, double>>> reverso(n);
+        std::vector<int32_t> posicao(n, -1);  // Posição do vizinho no CSR do vértice atual
+        m_inicio.push_back(0);
+        for (vertex v = 0; v < n; ++v) {
+            for (Edge* edge = graph.getEdges(v); edge; edge = edge->next()) {
+                vertex w = edge->otherVertex(v);
+                if (posicao[w] >= m_inicio[v]) {
+                    m_peso[posicao[w]] = std::min(m_peso[posicao[w]], edge->distance());
+                } else {
+                    posicao[w] = m_destinoArco.size();
+                    m_destinoArco.push_back(w);
+                    m_peso.push_back(edge->distance());
+                }
+            }
+            for (int32_t a = m_inicio[v]; a < (int32_t)m_destinoArco.size(); ++a) {
+                reverso[m_destinoArco[a]].push_back({v, (double)m_peso[a]});
+            }
+            m_inicio.push_back(m_destinoArco.size());
+        }
+        m_estimativa = custoAteODestino(reverso, destino);
+        m_distancia.assign(n, INF);
+        m_pai.assign(n, -1);
+        m_carimboVisto.assign(n, 0);
+        m_carimboBloqueado.assign(n, 0);
+        m_fechado.assign(n, 0);
+    }
+
+    vertex vertice(int32_t no) const { return no; }
+    double estimativa(int32_t no) const { return m_estimativa[no]; }
+
+    bool desviar(const CaminhoYen& raiz, size_t i, const std::vector<int32_t>& proibidos, double limite, CaminhoYen& saida) {
+        m_carimbo++;
+        for (size_t j = 0; j < i; ++j) m_carimboBloqueado[raiz.nos[j]] = m_carimbo;
+        m_limite = limite - raiz.custo[i];
+        vertex inicio = raiz.nos[i];
+        if (m_estimativa[inicio] == INF) return false;
+
+        m_fila.clear();
+        visitar(inicio, 0.0, -1);
+        while (!m_fila.empty()) {
+            std::pop_heap(m_fila.begin(), m_fila.end(), std::greater<>());
+            vertex v = m_fila.back().second;
+            m_fila.pop_back();
+            if (m_fechado[v] == m_carimbo) continue;
+            m_fechado[v] = m_carimbo;
+
+            if (v == m_destino) {
+                std::vector<vertex> caminho;
+                for (vertex u = v; u != -1; u = m_pai[u]) caminho.push_back(u);
+                std::reverse(caminho.begin(), caminho.end());
+                saida = CaminhoYen();
+                for (vertex u : caminho) {
+                    saida.nos.push_back(u);
+                    saida.custo.push_back(raiz.custo[i] + m_distancia[u]);
+                    saida.dinheiro.push_back(0.0);
+                }
+                return true;
+            }
+
+            for (int32_t a = m_inicio[v]; a < m_inicio[v + 1]; ++a) {
+                vertex w = m_destinoArco[a];
+                if (m_carimboBloqueado[w] == m_carimbo || m_estimativa[w] == INF) continue;
+                if (v == inicio && std::find(proibidos.begin(), proibidos.end(), w) != proibidos.end()) continue;
+                double nova = m_distancia[v] + m_peso[a];
+                if (m_carimboVisto[w] != m_carimbo || nova < m_distancia[w]) {
+                    visitar(w, nova, v);
+                }
+            }
+        }
+        return false;
+    }
+
+private:
+    void visitar(vertex v, double distancia, vertex pai) {
+        if (distancia + m_estimativa[v] >= m_limite) return;  // Não bateria o limite
+        m_carimboVisto[v] = m_carimbo;
+        m_distancia[v] = distancia;
+        m_pai[v] = pai;
+        m_fila.push_back({distancia + m_estimativa[v], v});
+        std::push_heap(m_fila.begin(), m_fila.end(), std::greater<>());
+    }
+
+    vertex m_destino;
+    std::vector<int32_t> m_inicio, m_destinoArco, m_peso;
+    std::vector<double> m_estimativa;
+
+    // Buffers reaproveitados entre desvios: entradas valem só com o carimbo atual
+    uint32_t m_carimbo = 0;
+    double m_limite = INF;
+    std::vector<double> m_distancia;
+    std::vector<vertex> m_pai;
+    std::vector<uint32_t> m_carimboVisto, m_carimboBloqueado, m_fechado;
+    std::vector<std::pair<double, vertex>> m_fila;
+};
+
+// Desvios multimodais: busca de rótulos A* no grafo de estados, com orçamento e máscara de modos
+class BuscaMultimodal {
+public:
+    BuscaMultimodal(const StateGraph& estados, vertex destino, double K, uint8_t mascaraModos)
+        : m_estados(estados), m_destino(destino), m_K(K), m_mascara(mascaraModos),
+          m_sacolas(estados.getNumVertices()), m_carimboBloqueado(estados.getNumVertices(), 0) {
+        // Limite inferior: menor tempo até o destino com qualquer modo, ignorando tarifas
+        std::vector<std::vector<std::pair<vertex, double>>> reverso(estados.getNumVertices());
+        for (int s = 0; s < estados.getNumEstados(); ++s) {
+            for (int32_t a = estados.inicio(s); a < estados.fim(s); ++a) {
+                if (!estados.permitido(a, m_mascara)) continue;
+                reverso[StateGraph::verticeDe(estados.destino(a))].push_back({StateGraph::verticeDe(s), estados.tempo(a)});
+            }
+        }
+        m_estimativa = custoAteODestino(reverso, destino);
+    }
+
+    vertex vertice(int32_t no) const { return StateGraph::verticeDe(no); }
+    double estimativa(int32_t no) const { return m_estimativa[StateGraph::verticeDe(no)]; }
+
+    bool desviar(const CaminhoYen& raiz, size_t i, const std::vector<int32_t>& proibidos, double limite, CaminhoYen& saida) {
+        m_carimbo++;
+        for (size_t j = 0; j < i; ++j) m_carimboBloqueado[StateGraph::verticeDe(raiz.nos[j])] = m_carimbo;
+        int32_t inicio = raiz.nos[i];
+        if (raiz.custo[i] + estimativa(inicio) >= limite) return false;
+
+        m_sacolas.reiniciar();
+        std::vector<Rotulo>& rotulos = m_sacolas.rotulos;
+        Rotulo primeiro{raiz.custo[i], raiz.dinheiro[i], StateGraph::verticeDe(inicio), -1, -1, StateGraph::modoDe(inicio), 0};
+        m_sacolas.inserir(primeiro, primeiro.tempoGasto + estimativa(inicio));
+
+        while (!m_sacolas.vazia()) {
+            int32_t indiceAtual = m_sacolas.retirar();
+            const Rotulo atual = rotulos[indiceAtual];
+            if (atual.dominado) continue;
+
+            // Com estimativa consistente, o primeiro rótulo a sair no destino é o mais rápido no orçamento
+            if (atual.atual == m_destino) {
+                std::vector<int32_t> cadeia;
+                for (int32_t r = indiceAtual; r != -1; r = rotulos[r].pai) cadeia.push_back(r);
+                std::reverse(cadeia.begin(), cadeia.end());
+                saida = CaminhoYen();
+                for (int32_t r : cadeia) {
+                    saida.nos.push_back(StateGraph::estado(rotulos[r].atual, rotulos[r].modoAtual));
+                    saida.custo.push_back(rotulos[r].tempoGasto);
+                    saida.dinheiro.push_back(rotulos[r].dinheiroGasto);
+                }
+                return true;
+            }
+
+            int s = StateGraph::estado(atual.atual, atual.modoAtual);
+            for (int32_t a = m_estados.inicio(s); a < m_estados.fim(s); ++a) {
+                if (!m_estados.permitido(a, m_mascara)) continue;
+                int destino = m_estados.destino(a);
+                vertex w = StateGraph::verticeDe(destino);
+                if (m_carimboBloqueado[w] == m_carimbo || m_estimativa[w] == INF) continue;
+                if (atual.pai == -1 && std::find(proibidos.begin(), proibidos.end(), w) != proibidos.end()) continue;
+
+                Rotulo novo{atual.tempoGasto + m_estados.tempo(a), atual.dinheiroGasto + m_estados.custo(a),
+                            w, indiceAtual, -1, StateGraph::modoDe(destino), 0};
+                double chave = novo.tempoGasto + m_estimativa[w];
+                if (novo.dinheiroGasto > m_K + EPS_DINHEIRO || chave >= limite) continue;
+                m_sacolas.inserir(novo, chave);
+            }
+        }
+        return false;
+    }
+
+private:
+    const StateGraph& m_estados;
+    vertex m_destino;
+    double m_K;
+    uint8_t m_mascara;
+    std::vector<double> m_estimativa;
+
+    // Reaproveitados entre desvios
+    SacolasPareto m_sacolas;
+    uint32_t m_carimbo = 0;
+    std::vector<uint32_t> m_carimboBloqueado;
+};
+
+} // namespace
+
+std::vector<std::pair<std::vector<vertex>, int>> k_caminhos_mais_curtos(Graph& graph, vertex origem, vertex destino, int k) {
+    std::vector<std::pair<std::vector<vertex>, int>> resultado;
+    int n = graph.getNumVertices();
+    if (origem < 0 || origem >= n || destino < 0 || destino >= n) return resultado;
+
+    BuscaDistancia busca(graph, destino);
+    for (const CaminhoYen& caminho : yen(busca, origem, k)) {
+        resultado.push_back({std::vector<vertex>(caminho.nos.begin(), caminho.nos.end()), (int)caminho.custo.back()});
+    }
+    return resultado;
+}
+
+std::vector<RotaPareto> k_rotas_mais_rapidas(Graph& grafo, vertex origem, vertex destino, double K, int k, uint8_t mascaraModos) {
+    std::vector<RotaPareto> resultado;
+    std::shared_ptr<const StateGraph> estados = StateGraph::compilado(grafo);
+    int n = estados->getNumVertices();
+    if (origem < 0 || origem >= n || destino < 0 || destino >= n) return resultado;
+
+    BuscaMultimodal busca(*estados, destino, K, mascaraModos);
+    for (const CaminhoYen& caminho : yen(busca, StateGraph::estado(origem, MODO_WALK), k)) {
+        RotaPareto rota{caminho.custo.back(), caminho.dinheiro.back(), {}};
+        for (int32_t no : caminho.nos) rota.caminho.push_back(StateGraph::verticeDe(no));
+        resultado.push_back(std::move(rota));
+    }
+    return resultado;
+}
@@ -0,0 +1,22 @@
+#ifndef KSHORTEST_H
+#define KSHORTEST_H
+
+#include <utility>
+#include <vector>
+#include "graph.h"
+#include "fastRoute.h"
+
+// Rotas alternativas pelo algoritmo de Yen: cada nova rota desvia de uma já aceita a partir de
+// um vértice dela (o "desvio"), proibindo as continuações já usadas. As buscas de desvio são A*
+// guiadas pela árvore reversa de caminhos mínimos até o destino, reaproveitam os mesmos buffers
+// (zerados por carimbo) e são puladas quando nem a melhor continuação entraria entre as k rotas.
+
+// Até k caminhos sem repetir vértices, em ordem crescente de distância (metros)
+std::vector<std::pair<std::vector<vertex>, int>> k_caminhos_mais_curtos(Graph& graph, vertex origem, vertex destino, int k);
+
+// Até k rotas multimodais com sequências de vértices distintas e sem repetir vértices, dentro do
+// orçamento K, em ordem crescente de tempo
+std::vector<RotaPareto> k_rotas_mais_rapidas(Graph& grafo, vertex origem, vertex destino, double K, int k,
+                                             uint8_t mascaraModos = TODOS_OS_MODOS);
+
+#endif // KSHORTEST_H
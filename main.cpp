@@ -1,6 +1,9 @@
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <climits>
+#include <cctype>
+#include <cstdlib>
 #include <unordered_map>
 #include "external/json.hpp"
 #include "graph.h"
@@ -8,70 +11,84 @@
 #include "bus.h"
 #include "bus3.h"
 #include "fastRoute.h"
+#include "ssspCache.h"
+#include "batchRoutes.h"
+#include "routeCache.h"
+#include "travelProfiles.h"
+#include "transitSchedule.h"
+#include "kShortest.h"
+#include "trafficAssignment.h"
+#include "stats.h"
+#include "memoryReport.h"
+#include <algorithm>
+#include <set>
 #include <tuple>
 #include <fstream>
 
 using json = nlohmann::json;
 
-// Function to load the graph from the JSON file
-void loadGraphFromJson(const std::string& filename, Graph& graph) {
-    // Open the JSON file and parse it
-    std::ifstream file(filename);
-    json graphData;
-    file >> graphData;
-
-    // Load nodes and edges
-    auto nodes = graphData["nodes"];
-    auto edges = graphData["edges"];
-
-    // Map node ids to integer indices
-    std::unordered_map<std::string, vertex> nodeMap;
-    vertex nodeId = 0;
-
-    // Add nodes to the graph
-    for (const auto& node : nodes) {
-        std::string nodeIdStr = node["id"];
-        
-        // Store node ID and region before incrementing
-        graph.setNodeId(nodeId, nodeIdStr); // Set node ID for the current vertex
-        graph.setRegion(nodeIdStr, node["region"]);  // Store the region
-        
-        nodeMap[nodeIdStr] = nodeId;  // Map node ID to current vertex index
-        nodeId++;  // Increment for the next node
-    }
-
-    // Add edges to the graph
-    for (const auto& edge : edges) {
-        std::string fromNodeId = edge["from"];
-        std::string toNodeId = edge["to"];
-        
-        // Get corresponding vertex indices for the node IDs
-        vertex v1 = nodeMap[fromNodeId];
-        vertex v2 = nodeMap[toNodeId];
-
-        // Read edge properties
-        int cost = edge["excavation_cost"];  // Assuming 'price_cost' is the cost
-        int distance = edge["distance"];
-        std::string transport_type = edge["transport_type"];
-        double max_speed = edge["max_speed"];
-        double price_cost = edge["price_cost"];
-        double time_cost = edge["time_cost"];
-        int num_residencial = edge["num_residencial"];
-        int num_commercial = edge["num_commercial"];
-        int num_touristic = edge["num_touristic"];
-        int num_industrial = edge["num_industrial"];
-        int bus_preference = edge["bus_preference"];
-
-        // Add the edge to the graph in both directions (undirected graph)
-        graph.addEdge(v1, v2, cost, distance, transport_type, max_speed, price_cost, time_cost, num_residencial, num_commercial, num_touristic, num_industrial, bus_preference);
-        graph.addEdge(v2, v1, cost, distance, transport_type, max_speed, price_cost, time_cost, num_residencial, num_commercial, num_touristic, num_industrial, bus_preference);
-    }
-}
-
-
-int main() {
+int main(int argc, char* argv[]) {
     const std::string filename = "city_graph.json";
 
+    // Opções: --batch <consultas.jsonl> <resultados.jsonl> [--threads N] | --atribuicao <consultas.jsonl>
+    //         [--stats <relatorio.json>] [--paradas <paradas por região>]
+    //         [--isocronas <origem> <orçamento> <minutos,...>]
+    std::string arquivoConsultas;
+    std::string arquivoResultados;
+    std::string arquivoDemanda;
+    std::string arquivoEstatisticas;
+    int numThreads = 0;
+    int paradasPorRegiao = 3;
+    std::string origemIsocronas;
+    double orcamentoIsocronas = 0;
+    std::vector<double> limitesIsocronas;
+    for (int i = 1; i < argc; ++i) {
+        std::string opcao = argv[i];
+        if (opcao == "--batch" && i + 2 < argc) {
+            arquivoConsultas = argv[++i];
+            arquivoResultados = argv[++i];
+        } else if (opcao == "--threads" && i + 1 < argc) {
+            numThreads = std::atoi(argv[++i]);
+        } else if (opcao == "--atribuicao" && i + 1 < argc) {
+            arquivoDemanda = argv[++i];
+        } else if (opcao == "--stats" && i + 1 < argc) {
+            arquivoEstatisticas = argv[++i];
+        } else if (opcao == "--paradas" && i + 1 < argc) {
+            paradasPorRegiao = std::atoi(argv[++i]);
+        } else if (opcao == "--isocronas" && i + 3 < argc) {
+            origemIsocronas = argv[++i];
+            orcamentoIsocronas = std::atof(argv[++i]);
+            std::stringstream limites(argv[++i]);
+            std::string limite;
+            while (std::getline(limites, limite, ',')) {
+                if (!limite.empty()) limitesIsocronas.push_back(std::atof(limite.c_str()));
+            }
+            std::sort(limitesIsocronas.begin(), limitesIsocronas.end());
+        } else {
+            std::cerr << "Uso: " << argv[0] << " [--batch <consultas.jsonl> <resultados.jsonl>] [--threads N]"
+                      << " [--atribuicao <consultas.jsonl>] [--stats <relatorio.json>] [--paradas N]"
+                      << " [--isocronas <origem> <orcamento> <minutos,...>]" << std::endl;
+            return 1;
+        }
+    }
+
+    // Relatório de fases, buscas e memória gravado na saída do main, por qualquer um dos returns
+    struct RelatorioNaSaida {
+        const std::string& arquivo;
+        ~RelatorioNaSaida() {
+            if (arquivo.empty()) return;
+            std::ofstream saida(arquivo);
+            if (!saida.is_open()) {
+                std::cerr << "Failed to open " << arquivo << std::endl;
+                return;
+            }
+            json relatorio = Estatisticas::global().relatorio();
+            relatorio["memory"] = RelatorioMemoria::global().relatorio();
+            saida << relatorio.dump(2) << std::endl;
+        }
+    } relatorioNaSaida{arquivoEstatisticas};
+    ESTAT_FASE(faseCarregar, "carregar_grafo");
+
     // First, parse the JSON to count the number of nodes
     std::ifstream file(filename);
     if (!file.is_open()) {
@@ -86,7 +103,81 @@ int main() {
     Graph graph(numVertices);
 
     // Load the graph from the JSON file
-    loadGraphFromJson(filename, graph);
+    if (!graph.loadFromJSON(filename)) {
+        return 1;
+    }
+    ESTAT_FIM(faseCarregar);
+
+    // Memória do grafo e dos caches, medida de novo antes de cada saída (o grafo cresce com o metrô)
+    RelatorioMemoria& memoria = RelatorioMemoria::global();
+    auto medirMemoria = [&]() {
+        memoria.registrarGrafo(graph);
+        memoria.registrarCaches();
+    };
+    medirMemoria();
+
+    // Atribuição de tráfego: cada linha do arquivo (formato do --batch) é um veículo na hora de pico
+    if (!arquivoDemanda.empty()) {
+        std::ifstream entrada(arquivoDemanda);
+        if (!entrada.is_open()) {
+            std::cerr << "Failed to open " << arquivoDemanda << std::endl;
+            return 1;
+        }
+        std::vector<ViagemOD> viagens;
+        std::vector<ConsultaRota> consultas;
+        std::string linha;
+        while (std::getline(entrada, linha)) {
+            if (linha.empty()) continue;
+            ConsultaRota consulta = lerConsultaRota(linha, graph);
+            if (consulta.erro.empty()) {
+                viagens.push_back({consulta.origem, consulta.destino, 0});
+                consultas.push_back(consulta);
+            }
+        }
+
+        ParametrosAtribuicao parametros;
+        parametros.numThreads = numThreads;
+        ESTAT_FASE(faseAtribuicao, "atribuirTrafego");
+        ResultadoAtribuicao atribuicao = atribuirTrafego(graph, viagens, parametros);
+        ESTAT_FIM(faseAtribuicao);
+        std::cout << "Atribuicao de trafego: " << viagens.size() << " viagens, " << atribuicao.iteracoes
+                  << " iteracoes, gap relativo " << atribuicao.gapRelativo << std::endl;
+        std::cout << "Tempo total na rede: " << atribuicao.tempoTotal / 3600 << " veiculo-hora" << std::endl;
+
+        // Ruas mais carregadas (arestas paralelas da mesma rua aparecem uma vez)
+        std::vector<int> ruas;
+        std::set<std::pair<vertex, vertex>> vistas;
+        for (int id = 0; id < graph.getNumEdgeIds(); ++id) {
+            Edge* edge = graph.getEdgeById(id);
+            if (edge && atribuicao.fluxo[id] > 0 && vistas.insert({edge->v1(), edge->v2()}).second) ruas.push_back(id);
+        }
+        std::sort(ruas.begin(), ruas.end(), [&](int a, int b) { return atribuicao.fluxo[a] > atribuicao.fluxo[b]; });
+        for (size_t i = 0; i < ruas.size() && i < 5; ++i) {
+            Edge* edge = graph.getEdgeById(ruas[i]);
+            std::cout << graph.getNodeId(edge->v1()) << " -> " << graph.getNodeId(edge->v2()) << ": "
+                      << atribuicao.fluxo[ruas[i]] << " veiculos/h, " << edge->time_cost() << " s livre, "
+                      << atribuicao.tempo[ruas[i]] << " s congestionado" << std::endl;
+        }
+
+        // Os tempos congestionados passam a valer para as rotas de taxi: a primeira consulta do
+        // arquivo é respondida antes e depois de aplicá-los
+        std::pair<std::vector<vertex>, double> livre, congestionado;
+        if (!consultas.empty()) {
+            livre = obter_melhor_trajeto(graph, consultas[0].origem, consultas[0].destino, consultas[0].orcamento, consultas[0].mascaraModos);
+        }
+        aplicarTemposCongestionados(graph, atribuicao);
+        if (!consultas.empty()) {
+            congestionado = obter_melhor_trajeto(graph, consultas[0].origem, consultas[0].destino, consultas[0].orcamento, consultas[0].mascaraModos);
+            std::cout << "Rota de " << graph.getNodeId(consultas[0].origem) << " para " << graph.getNodeId(consultas[0].destino) << ": ";
+            if (livre.first.empty() || congestionado.first.empty()) {
+                std::cout << "sem rota no orçamento" << std::endl;
+            } else {
+                std::cout << livre.second << " minutos livre, " << congestionado.second << " minutos congestionado" << std::endl;
+            }
+        }
+        medirMemoria();
+        return 0;
+    }
 
     // Print the graph to check if the edges are correctly loaded
     // std::cout << "Graph edges:" << std::endl;
@@ -94,24 +185,21 @@ int main() {
 
     std::cout << "Iniciando escavacaoMetro..." << std::endl;
     
-    std::tuple<std::vector<Edge*>, int,  std::unordered_map<vertex, std::tuple<std::vector<vertex>, std::vector<int>>>> result = escavacaoMetro(graph);
-    std::vector<Edge*> mst = std::get<0>(result);
-    int totalCost = std::get<1>(result);
-     std::unordered_map<vertex, std::tuple<std::vector<vertex>, std::vector<int>>> estacoes = std::get<2>(result);
+    ESTAT_FASE(faseMetro, "escavacaoMetro");
+    std::tuple<std::vector<Edge*>, int, SptStore> result = escavacaoMetro(graph);
+    ESTAT_FIM(faseMetro);
+    std::vector<Edge*>& mst = std::get<0>(result);
+    const SptStore& estacoes = std::get<2>(result);
+    memoria.registrar("escavacaoMetro.trees", estacoes.bytes());
 
 
 
     std::cout << "Estacoes feitas nos nós: " << std::endl;
-    for (const auto& entry1 : estacoes) {
-        vertex v1 = entry1.first;
-
-        // Access the parent and distancia vectors from the tuple
-        const std::vector<vertex>& parent = std::get<0>(entry1.second);  // parent vector
-        const std::vector<int>& distancia = std::get<1>(entry1.second);  // distancia vector
-
-        for (const auto& entry2 : estacoes) {
-            vertex v2 = entry2.first;
+    for (vertex v1 : estacoes.sources()) {
+        // Access the distancia row of the station's tree (shared, not copied)
+        const int* distancia = estacoes.distance(estacoes.find(v1));
 
+        for (vertex v2 : estacoes.sources()) {
             if (v1 != v2) {
                 graph.addEdge(v1, v2, 0, distancia[v2], "metro", 20, 0, 0, 0, 0, 0, 0, 0);
             }
@@ -143,36 +231,108 @@ int main() {
     }
     outFile << "]" << std::endl;
 
+    ESTAT_FASE(faseOnibus, "designBusRoute");
     designBusRoute(graph);
+    ESTAT_FIM(faseOnibus);
 
     outFile.close();
 
     std::cout << "Custo total de excavacao: " << std::get<1>(result) << std::endl;
 
     // 1. Calcular a matriz de distâncias entre as paradas de ônibus
+    const int distanciaMinimaParadas = 800;
     std::cout << "Calculando a matriz de distâncias..." << std::endl;
     std::vector<vertex> todosVertices;
-    std::vector<std::vector<int>> matrizDistancias = calcularMatrizDeDistancias(graph, todosVertices);
+    ESTAT_FASE(faseMatriz, "calcularMatrizDeDistancias");
+    std::vector<std::vector<int>> matrizDistancias = calcularMatrizDeDistancias(graph, todosVertices, paradasPorRegiao, distanciaMinimaParadas);
+    ESTAT_FIM(faseMatriz);
 
-    // Verificar se coletamos exatamente 12 vértices
-    if (todosVertices.size() != 12) {
-        std::cerr << "Erro: Esperado 12 vértices, mas coletados " << todosVertices.size() << std::endl;
+    // Verificar se há paradas suficientes para formar uma rede
+    if (todosVertices.size() < 2) {
+        std::cerr << "Erro: Esperado pelo menos 2 paradas, mas coletadas " << todosVertices.size() << std::endl;
         return 1;
     }
+    if (todosVertices.size() < criarRegioes(graph).size() * paradasPorRegiao) {
+        std::cerr << "Aviso: algumas regiões não comportam " << paradasPorRegiao << " paradas a "
+                  << distanciaMinimaParadas << " m umas das outras; coletadas " << todosVertices.size() << std::endl;
+    }
+
+    // Ordem de visita das paradas no ciclo de ônibus
+    ESTAT_FASE(faseCiclo, "designBusCycle");
+    std::vector<vertex> cicloParadas = designBusCycle(graph, todosVertices, matrizDistancias);
+    ESTAT_FIM(faseCiclo);
+    std::cout << "Ciclo de ônibus pelas paradas: ";
+    for (vertex parada : cicloParadas) {
+        std::cout << parada << " ";
+    }
+    std::cout << std::endl;
 
     // 2. Criar um grafo com as distâncias e adicionar arestas
-    Graph graphDistancias(todosVertices.size()); // 12 vértices
+    Graph graphDistancias(todosVertices.size()); // Um vértice por parada
     adicionarArestasAoGrafo(graphDistancias, matrizDistancias);
 
     // 3. Calcular a MST (Árvore Geradora Mínima) usando Kruskal e adicionar as arestas ao grafo original
     std::cout << "Calculando a MST..." << std::endl;
+    ESTAT_FASE(faseMST, "calcularMST");
     calcularMST(graph, graphDistancias, todosVertices);
+    ESTAT_FIM(faseMST);
 
     // (Opcional) Imprimir o grafo para verificar as arestas
     std::cout << "Grafo atualizado após adicionar as arestas da MST:" << std::endl;
     graph.print();
 
+    std::cout << "Cache de Dijkstra: " << SsspCache::compartilhado().getHits() << " acertos, "
+              << SsspCache::compartilhado().getMisses() << " faltas" << std::endl;
+
+    // Isócronas sobre a rede completa: vértices alcançados a partir da origem (node ID ou índice)
+    // dentro do orçamento, agrupados pelas faixas de minutos pedidas
+    if (!origemIsocronas.empty()) {
+        vertex origem = graph.getVertex(origemIsocronas);
+        if (origem == -1 && std::all_of(origemIsocronas.begin(), origemIsocronas.end(), ::isdigit)) {
+            origem = std::atoi(origemIsocronas.c_str());
+        }
+        if (origem < 0 || origem >= graph.getNumVertices() || limitesIsocronas.empty()) {
+            std::cerr << "Origem ou faixas de isócrona inválidas: " << origemIsocronas << std::endl;
+            return 1;
+        }
+        ESTAT_FASE(faseIsocronas, "isocronas");
+        AlcanceOrigem alcance = tempos_de_alcance(graph, origem, orcamentoIsocronas, limitesIsocronas.back());
+        std::vector<std::vector<vertex>> faixas = isocronas(alcance, limitesIsocronas);
+        ESTAT_FIM(faseIsocronas);
+        for (size_t i = 0; i < faixas.size(); ++i) {
+            std::cout << "Isócrona (" << (i == 0 ? 0.0 : limitesIsocronas[i - 1]) << ", " << limitesIsocronas[i]
+                      << "] min: " << faixas[i].size() << " vértices:";
+            for (vertex v : faixas[i]) {
+                std::cout << " " << graph.getNodeId(v);
+            }
+            std::cout << std::endl;
+        }
+        medirMemoria();
+        return 0;
+    }
+
+    // Modo em lote: responde todas as consultas do arquivo sobre a rede completa
+    if (!arquivoConsultas.empty()) {
+        std::cout << "Executando consultas de " << arquivoConsultas << "..." << std::endl;
+        RouteCache cacheRotas;
+        ESTAT_FASE(faseLote, "executarConsultasEmLote");
+        ResumoLote resumo = executarConsultasEmLote(graph, arquivoConsultas, arquivoResultados, numThreads, &cacheRotas);
+        ESTAT_FIM(faseLote);
+        std::cout << resumo.consultas << " consultas (" << resumo.encontradas << " com rota, "
+                  << resumo.invalidas << " inválidas) em " << resumo.segundos << " s";
+        if (resumo.segundos > 0) {
+            std::cout << " - " << resumo.consultas / resumo.segundos << " consultas/s";
+        }
+        std::cout << std::endl;
+        std::cout << "Cache de rotas: " << cacheRotas.getHits() << " acertos, " << cacheRotas.getMisses()
+                  << " faltas (" << 100.0 * cacheRotas.taxaAcerto() << "%)" << std::endl;
+        medirMemoria();
+        return 0;
+    }
+
+    ESTAT_FASE(faseRota, "obter_melhor_trajeto");
     std::pair<std::vector<vertex>, double> resultado = obter_melhor_trajeto(graph, 1, 40, 12);
+    ESTAT_FIM(faseRota);
 
     // Verificação e exibição do resultado
     if (!resultado.first.empty()) {
@@ -187,5 +347,76 @@ int main() {
     } else {
         std::cout << "Não foi encontrado um caminho válido dentro do limite de custo." << std::endl; }
 
+    // Alternativas à melhor rota, em ordem de tempo
+    ESTAT_FASE(faseAlternativas, "k_rotas_mais_rapidas");
+    std::vector<RotaPareto> alternativas = k_rotas_mais_rapidas(graph, 1, 40, 12, 3);
+    ESTAT_FIM(faseAlternativas);
+    for (size_t i = 1; i < alternativas.size(); ++i) {
+        std::cout << "Alternativa " << i << ": ";
+        for (size_t j = 0; j < alternativas[i].caminho.size(); ++j) {
+            std::cout << alternativas[i].caminho[j] << (j + 1 < alternativas[i].caminho.size() ? " -> " : "");
+        }
+        std::cout << " (" << alternativas[i].tempo << " minutos)" << std::endl;
+    }
+
+    // Caminhos mais curtos só por distância, sem considerar modos nem tarifas
+    ESTAT_FASE(faseCaminhosCurtos, "k_caminhos_mais_curtos");
+    std::vector<std::pair<std::vector<vertex>, int>> caminhosCurtos = k_caminhos_mais_curtos(graph, 1, 40, 3);
+    ESTAT_FIM(faseCaminhosCurtos);
+    for (size_t i = 0; i < caminhosCurtos.size(); ++i) {
+        std::cout << "Caminho curto " << i + 1 << ": ";
+        for (size_t j = 0; j < caminhosCurtos[i].first.size(); ++j) {
+            std::cout << caminhosCurtos[i].first[j] << (j + 1 < caminhosCurtos[i].first.size() ? " -> " : "");
+        }
+        std::cout << " (" << caminhosCurtos[i].second << " metros)" << std::endl;
+    }
+
+    // Horário de pico: às 8h e às 18h o taxi leva quase o dobro do tempo
+    TravelProfiles perfis;
+    int pico = perfis.adicionarPerfil({{0, 1.0}, {360, 1.0}, {480, 2.0}, {600, 1.0}, {1020, 1.0}, {1080, 1.8}, {1200, 1.0}});
+    for (int id = 0; id < graph.getNumEdgeIds(); ++id) {
+        Edge* edge = graph.getEdgeById(id);
+        if (edge && edge->transport_type() == "taxi") {
+            perfis.atribuir(graph, id, pico);
+        }
+    }
+    ESTAT_FASE(fasePico, "obter_trajeto_no_horario");
+    std::pair<std::vector<vertex>, double> noPico = obter_trajeto_no_horario(graph, perfis, 1, 40, 12, 480);
+    ESTAT_FIM(fasePico);
+    if (!noPico.first.empty()) {
+        std::cout << "Saindo às 8h: " << noPico.second << " minutos (" << noPico.first.size() - 1 << " trechos)" << std::endl;
+    }
+
+    // Metrô e ônibus com horário: linhas da árvore de túneis e do ciclo de paradas
+    ESTAT_FASE(faseTransito, "transporte_publico");
+    TransitSchedule horarios;
+    for (const LinhaTransporte& linha : linhasDoMetro(mst, estacoes.sources())) {
+        horarios.adicionarLinha(linha);
+    }
+    horarios.adicionarLinha(linhaDeOnibusCircular(graph, cicloParadas));
+    horarios.preparar(graph);
+
+    // Consulta de exemplo entre paradas de linhas diferentes (a primeira do metrô e a do meio do
+    // ônibus): vértices quaisquer costumam ficar a mais de maxCaminhada de qualquer parada
+    const LinhaTransporte& primeiraLinha = horarios.getLinha(0);
+    const LinhaTransporte& linhaOnibus = horarios.getLinha(horarios.getNumLinhas() - 1);
+    vertex origemTransito = primeiraLinha.paradas.empty() ? 0 : primeiraLinha.paradas.front();
+    vertex destinoTransito = linhaOnibus.paradas.empty() ? graph.getNumVertices() - 1
+                                                         : linhaOnibus.paradas[linhaOnibus.paradas.size() / 2];
+    ResultadoTransito viagem = horarios.consultar(origemTransito, destinoTransito, 480);
+    ESTAT_FIM(faseTransito);
+    std::cout << "Transporte público de " << origemTransito << " para " << destinoTransito << " saindo às 8h: ";
+    if (viagem.trechos.empty()) {
+        std::cout << "sem viagem" << std::endl;
+    } else {
+        std::cout << viagem.chegada - 480 << " minutos, " << viagem.embarques << " embarque(s)" << std::endl;
+        for (const TrechoTransito& trecho : viagem.trechos) {
+            std::cout << "  " << (trecho.linha == -1 ? "Caminhada" : horarios.getLinha(trecho.linha).nome) << ": "
+                      << trecho.origem << " -> " << trecho.destino << " (" << trecho.partida << " - " << trecho.chegada << ")" << std::endl;
+        }
+    }
+
+    memoria.registrar("travel_profiles", perfis.bytes());
+    medirMemoria();
     return 0;
 }
\ No newline at end of file
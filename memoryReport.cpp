@@ -0,0 +1,133 @@
+#include "memoryReport.h"
+#include <cstdio>
+#include <cstring>
+#include "ssspCache.h"
+#include "stateGraph.h"
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+#if defined(__linux__)
+// Valor em kB de um campo de /proc/self/status (ex. "VmRSS:"), -1 se não existir
+long lerStatusKb(const char* campo) {
+    FILE* status = std::fopen("/proc/self/status", "r");
+    if (!status) return -1;
+    char linha[256];
+    long kb = -1;
+    size_t tamanho = std::strlen(campo);
+    while (std::fgets(linha, sizeof(linha), status)) {
+        if (std::strncmp(linha, campo, tamanho) == 0) {
+            std::sscanf(linha + tamanho, "%ld", &kb);
+            break;
+        }
+    }
+    std::fclose(status);
+    return kb;
+}
+#endif
+
+} // namespace
+
+long picoRssKb() {
+#if defined(__linux__)
+    // VmHWM vem da mesma contagem que VmRSS, então o pico nunca fica abaixo do atual
+    return lerStatusKb("VmHWM:");
+#elif defined(_WIN32)
+    return -1;
+#else
+    struct rusage uso;
+    if (getrusage(RUSAGE_SELF, &uso) != 0) return -1;
+#if defined(__APPLE__)
+    return uso.ru_maxrss / 1024;  // Bytes no macOS
+#else
+    return uso.ru_maxrss;
+#endif
+#endif
+}
+
+long rssAtualKb() {
+#if defined(__linux__)
+    return lerStatusKb("VmRSS:");
+#else
+    return -1;
+#endif
+}
+
+MemoriaGrafo estimarMemoriaGrafo(size_t numVertices, size_t numArestas, size_t tamanhoMedioId) {
+    // Mesmas contas de Graph::memoria, com vetores sem folga e um balde por elemento nos mapas
+    MemoriaGrafo memoria;
+    size_t idFora = tamanhoMedioId > 15 ? bytesAlocacao(tamanhoMedioId + 1) : 0;
+    size_t baldes = bytesAlocacao(numVertices * sizeof(void*));
+    memoria.adjacencia = numArestas * bytesAlocacao(sizeof(Edge)) + bytesAlocacao(numArestas * sizeof(Edge*)) +
+                         numVertices * bytesAlocacao(sizeof(void*) + sizeof(std::pair<const vertex, Edge*>)) + baldes;
+    memoria.atributos = 4 * bytesAlocacao(numArestas * sizeof(int)) + bytesAlocacao(numArestas * sizeof(double));
+    memoria.ids = bytesAlocacao(numVertices * sizeof(std::string)) + numVertices * idFora;
+    size_t noMapa = bytesAlocacao(sizeof(void*) + sizeof(std::pair<const std::string, int>) + sizeof(size_t));
+    memoria.indices = 2 * (numVertices * (noMapa + idFora) + baldes);
+    return memoria;
+}
+
+RelatorioMemoria& RelatorioMemoria::global() {
+    static RelatorioMemoria relatorio;
+    return relatorio;
+}
+
+void RelatorioMemoria::registrar(const std::string& componente, size_t bytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& entrada : m_componentes) {
+        if (entrada.first == componente) {
+            entrada.second = bytes;
+            return;
+        }
+    }
+    m_componentes.push_back({componente, bytes});
+}
+
+void RelatorioMemoria::registrarGrafo(const Graph& graph, const std::string& prefixo) {
+    MemoriaGrafo memoria = graph.memoria();
+    registrar(prefixo + ".adjacency", memoria.adjacencia);
+    registrar(prefixo + ".attributes", memoria.atributos);
+    registrar(prefixo + ".node_ids", memoria.ids);
+    registrar(prefixo + ".indexes", memoria.indices);
+}
+
+void RelatorioMemoria::registrarCaches() {
+    registrar("sssp_cache", SsspCache::compartilhado().bytes());
+    std::shared_ptr<const StateGraph> estados = StateGraph::compiladoAtual();
+    registrar("state_graph", estados ? estados->bytes() : 0);
+}
+
+size_t RelatorioMemoria::bytes(const std::string& componente) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto& entrada : m_componentes) {
+        if (entrada.first == componente) return entrada.second;
+    }
+    return 0;
+}
+
+size_t RelatorioMemoria::total() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t total = 0;
+    for (const auto& entrada : m_componentes) total += entrada.second;
+    return total;
+}
+
+void RelatorioMemoria::limpar() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_componentes.clear();
+}
+
+nlohmann::json RelatorioMemoria::relatorio() const {
+    nlohmann::json relatorio;
+    relatorio["components"] = nlohmann::json::object();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto& entrada : m_componentes) relatorio["components"][entrada.first] = entrada.second;
+    }
+    relatorio["total_bytes"] = total();
+    relatorio["current_rss_kb"] = rssAtualKb();
+    relatorio["peak_rss_kb"] = picoRssKb();
+    return relatorio;
+}
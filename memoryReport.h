@@ -0,0 +1,75 @@
+#ifndef MEMORYREPORT_H
+#define MEMORYREPORT_H
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "external/json.hpp"
+#include "graph.h"
+
+// Contabilidade de memória: bytes por componente (grafo, árvores, caches) e pico de memória
+// residente do processo. Os tamanhos são estimativas a partir das capacidades dos containers,
+// contando o cabeçalho e o arredondamento de cada bloco do malloc (glibc, 64 bits).
+
+// Bytes de um bloco de n bytes pedido ao malloc: 8 de cabeçalho, múltiplo de 16, mínimo 32
+inline size_t bytesAlocacao(size_t n) {
+    if (n == 0) return 0;
+    size_t bloco = (n + 8 + 15) & ~(size_t)15;
+    return bloco < 32 ? 32 : bloco;
+}
+
+// Parte de uma string fora do objeto (strings de até 15 caracteres ficam no próprio objeto)
+inline size_t bytesString(const std::string& s) {
+    return s.capacity() > 15 ? bytesAlocacao(s.capacity() + 1) : 0;
+}
+
+template <class T>
+size_t bytesVetor(const std::vector<T>& v) {
+    return bytesAlocacao(v.capacity() * sizeof(T));
+}
+
+// Nós e baldes de um std::unordered_map da libstdc++ (chaves que não são inteiros guardam o hash
+// no nó). Strings longas nas chaves não entram na conta.
+template <class Mapa>
+size_t bytesMapaHash(const Mapa& mapa) {
+    size_t no = sizeof(void*) + sizeof(typename Mapa::value_type) +
+                (std::is_integral<typename Mapa::key_type>::value ? 0 : sizeof(size_t));
+    return mapa.size() * bytesAlocacao(no) + bytesAlocacao(mapa.bucket_count() * sizeof(void*));
+}
+
+// Pico e valor atual da memória residente do processo em KB (-1 se indisponível)
+long picoRssKb();
+long rssAtualKb();
+
+// Memória que um Graph ocuparia com numVertices vértices, numArestas arestas e node IDs com
+// tamanhoMedioId caracteres, para saber se uma cidade cabe antes de carregá-la
+MemoriaGrafo estimarMemoriaGrafo(size_t numVertices, size_t numArestas, size_t tamanhoMedioId = 10);
+
+// Bytes por componente, com nomes livres ("graph.adjacency", "sssp_cache"...). Registrar um nome
+// de novo substitui o valor anterior, então o relatório guarda a última medição de cada um.
+class RelatorioMemoria {
+public:
+    static RelatorioMemoria& global();
+
+    void registrar(const std::string& componente, size_t bytes);
+    // graph.adjacency, graph.attributes, graph.node_ids e graph.indexes com o prefixo dado
+    void registrarGrafo(const Graph& graph, const std::string& prefixo = "graph");
+    // Cache de Dijkstra compartilhado e grafo de estados compilado atual
+    void registrarCaches();
+
+    size_t bytes(const std::string& componente) const;  // 0 se não registrado
+    size_t total() const;
+    void limpar();
+
+    // {"components": {nome: bytes}, "total_bytes", "current_rss_kb", "peak_rss_kb"}
+    nlohmann::json relatorio() const;
+
+private:
+    mutable std::mutex m_mutex;
+    std::vector<std::pair<std::string, size_t>> m_componentes;  // Na ordem do primeiro registro
+};
+
+#endif // MEMORYREPORT_H
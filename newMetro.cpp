@@ -1,39 +1,51 @@
 #include "newMetro.h"
+#include "ssspCache.h"
+#include "stats.h"
 #include <climits>
 #include <vector>
 #include <algorithm>
 #include "graph.h"
 #include <limits.h>
 #include <tuple>
+#include <queue>
+#include <functional>
 
-void Dijkstra::cptDijkstraFast(vertex v0, vertex* parent, int* distance, Graph& graph) {
+void Dijkstra::cptDijkstraFast(vertex v0, vertex* parent, int* distance, Graph& graph, int* parentEdge) {
     std::vector<bool> checked(graph.getNumVertices(), false);
     Heap heap; // Create the heap
+    ContadoresBusca contadores;
+    ESTAT_CONTAR(contadores, buscas);
     
     // Initialize arrays
     for (vertex v = 0; v < graph.getNumVertices(); v++) {
         parent[v] = -1;
         distance[v] = INT_MAX;
         checked[v] = false;
+        if (parentEdge) { parentEdge[v] = -1; }
     }
     parent[v0] = v0;
     distance[v0] = 0;
     heap.insert_or_update(distance[v0], v0); // Add starting vertex to heap
+    ESTAT_CONTAR(contadores, insercoes);
 
     while (!heap.empty()) {
         vertex v1 = heap.top().second; // Get vertex with the smallest distance
         heap.pop(); // Remove it from the heap
         
         if (distance[v1] == INT_MAX) { break; } // Exit if remaining vertices are unreachable
+        ESTAT_CONTAR(contadores, assentados);
 
         // Iterate through all edges connected to v1
         Edge* edge = graph.getEdges(v1); // Access edges from the Graph
         while (edge) {
             vertex v2 = edge->otherVertex(v1); // Get the other vertex of the edge
+            ESTAT_CONTAR(contadores, relaxadas);
             if (!checked[v2]) {
                 int current_distance = edge->distance(); // Get the cost from the edge
                 if (distance[v1] + current_distance < distance[v2]) {
+                    if (distance[v2] == INT_MAX) ESTAT_CONTAR(contadores, insercoes); else ESTAT_CONTAR(contadores, reducoes);
                     parent[v2] = v1;
+                    if (parentEdge) { parentEdge[v2] = edge->id(); }
                     distance[v2] = distance[v1] + current_distance;
                     heap.insert_or_update(distance[v2], v2); // Update heap with new distance
                 }
@@ -42,6 +54,52 @@ void Dijkstra::cptDijkstraFast(vertex v0, vertex* parent, int* distance, Graph&
         }
         checked[v1] = true; // Mark the vertex as checked
     }
+    ESTAT_REGISTRAR_BUSCA("dijkstra", contadores);
+}
+
+void Dijkstra::updateMultiSource(vertex source, int* distance, Graph& graph) {
+    // Fila com remoção preguiçosa: entradas desatualizadas são descartadas ao sair
+    std::priority_queue<std::pair<int, vertex>, std::vector<std::pair<int, vertex>>, std::greater<>> heap;
+    ContadoresBusca contadores;
+    ESTAT_CONTAR(contadores, buscas);
+    distance[source] = 0;
+    heap.push({0, source});
+    ESTAT_CONTAR(contadores, insercoes);
+
+    while (!heap.empty()) {
+        auto [d, v1] = heap.top();
+        heap.pop();
+        if (d > distance[v1]) continue;
+        ESTAT_CONTAR(contadores, assentados);
+
+        Edge* edge = graph.getEdges(v1);
+        while (edge) {
+            vertex v2 = edge->otherVertex(v1);
+            int nova = d + edge->distance();
+            ESTAT_CONTAR(contadores, relaxadas);
+            if (nova < distance[v2]) { // Poda: vértices já mais perto de outra fonte não são expandidos
+                if (distance[v2] == INT_MAX) ESTAT_CONTAR(contadores, insercoes); else ESTAT_CONTAR(contadores, reducoes);
+                distance[v2] = nova;
+                heap.push({nova, v2});
+            }
+            edge = edge->next();
+        }
+    }
+    ESTAT_REGISTRAR_BUSCA("dijkstra_multi_fonte", contadores);
+}
+
+std::vector<Edge*> Dijkstra::unpackPath(vertex v0, vertex target, const vertex* parent, const int* parentEdge, const Graph& graph) {
+    std::vector<Edge*> path;
+    if (parent[target] == -1) { return path; } // target não foi alcançado
+
+    // Cada passo lê diretamente a aresta registrada, sem percorrer a lista de adjacência do pai
+    for (vertex current = target; current != v0; current = parent[current]) {
+        Edge* edge = graph.getEdgeById(parentEdge[current]);
+        if (!edge) { return {}; } // Aresta removida depois da busca
+        path.push_back(edge);
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
 }
 
 void Kruskal::mstKruskalFast(std::vector<Edge*>& mstEdges, Graph& graph) {
@@ -97,7 +155,7 @@ std::vector<std::vector<vertex>> criarRegioes(Graph& graph) {
     return regioes;
 }
 
-std::tuple<std::vector<Edge*>, int,  std::unordered_map<vertex, std::tuple<std::vector<vertex>, std::vector<int>>>> escavacaoMetro(Graph& graph) {
+std::tuple<std::vector<Edge*>, int, SptStore> escavacaoMetro(Graph& graph) {
     std::vector<vertex> estacoes;
     std::vector<Edge*> solucao;  
     std::vector<std::vector<vertex>> regioes;
@@ -105,22 +163,17 @@ std::tuple<std::vector<Edge*>, int,  std::unordered_map<vertex, std::tuple<std::
     regioes = criarRegioes(graph);
     int numVertices = graph.getNumVertices();
 
-    // Updated parentMap to store a tuple (parent, distancia)
-    std::unordered_map<vertex, std::tuple<std::vector<vertex>, std::vector<int>>> parentMap;
-
+    // Árvores (parent, parentEdge, distancia) de cada estação, em um único bloco contíguo
+    SptStore arvores(numVertices);
+    SsspCache& cache = SsspCache::compartilhado();
 
     for (const auto& regiao : regioes) {
-        std::vector<vertex> bestParent;
-        std::vector<int> bestDistancia;
-
         int minMaxDist = INT_MAX;
         vertex c_min = -1;
 
         for (vertex v : regiao) {
-            std::vector<int> distancia(numVertices, INT_MAX); 
-            std::vector<vertex> parent(numVertices, -1);      
-            
-            Dijkstra::cptDijkstraFast(v, parent.data(), distancia.data(), graph);
+            // Árvore do candidato vem do cache compartilhado (Dijkstra só na primeira vez)
+            const int* distancia = cache.consultar(graph, v).distance;
 
             int maxDist = 0;
             for (vertex r : regiao) {
@@ -129,63 +182,40 @@ std::tuple<std::vector<Edge*>, int,  std::unordered_map<vertex, std::tuple<std::
 
             if (maxDist < minMaxDist) {
                 minMaxDist = maxDist;
-                bestParent = parent;
-                bestDistancia = distancia;
                 c_min = v;
             }
         }
 
+        if (c_min == -1) continue;
         estacoes.push_back(c_min);
 
-        // Store both bestParent and bestDistancia in the tuple
-        parentMap[c_min] = std::make_tuple(bestParent, bestDistancia);
+        // Uma única cópia por região: a árvore da estação escolhida
+        SptView<int> melhor = cache.consultar(graph, c_min);
+        int slot = arvores.acquireSlot();
+        std::copy(melhor.parent, melhor.parent + numVertices, arvores.parent(slot));
+        std::copy(melhor.parentEdge, melhor.parentEdge + numVertices, arvores.parentEdge(slot));
+        std::copy(melhor.distance, melhor.distance + numVertices, arvores.distance(slot));
+        arvores.bind(c_min, slot);
     }
 
     // Construindo um subgrafo
     Graph subgrafo(numVertices);
 
     for (vertex v1 : estacoes) {
+        int slot = arvores.find(v1);
         for (vertex v2 : estacoes) {
             if (v1 == v2) continue; // Skip if both vertices are the same
 
-            // Retrieve the parent and distancia arrays for station v1
-            auto it = parentMap.find(v1);
-            if (it == parentMap.end()) {
-                std::cerr << "No parent array found for station " << v1 << std::endl;
+            std::vector<Edge*> caminho = Dijkstra::unpackPath(v1, v2, arvores.parent(slot), arvores.parentEdge(slot), graph);
+            if (caminho.empty()) {
+                std::cerr << "No path from " << v1 << " to " << v2 << std::endl;
                 continue;
             }
 
-            const std::vector<vertex>& parent = std::get<0>(it->second); // Get the parent vector
-            const std::vector<int>& distancia = std::get<1>(it->second); // Get the distancia vector
-
-            // Traverse from v2 back to v1 using the parent array
-            vertex current = v2;
-            while (current != v1 && current != -1) {
-                vertex p = parent[current];
-                if (p == -1) {
-                    std::cerr << "No path from " << v1 << " to " << v2 << std::endl;
-                    break;
-                }
-
-                // Add the edge between p and current to the subgrafo
-                // Retrieve the original edge's cost and distance from the main graph
-                Edge* originalEdge = graph.getEdges(p);
-                bool edgeFound = false;
-                while (originalEdge) {
-                    if (originalEdge->otherVertex(p) == current) {
-                        subgrafo.addEdge(p, current, originalEdge->cost(), originalEdge->distance(), originalEdge->transport_type(), originalEdge->max_speed(), originalEdge->price_cost(), originalEdge->time_cost(), originalEdge->num_residencial(), originalEdge->num_commercial(), originalEdge->num_touristic(), originalEdge->num_industrial(), originalEdge->bus_preference());
-                        edgeFound = true;
-                        break;
-                    }
-                    originalEdge = originalEdge->next();
-                }
-
-                if (!edgeFound) {
-                    std::cerr << "Edge not found between " << p << " and " << current << std::endl;
-                    break;
-                }
-
-                current = p; // Move to the parent vertex
+            // Add the path edges to the subgrafo, from v2 back to v1
+            for (auto itEdge = caminho.rbegin(); itEdge != caminho.rend(); ++itEdge) {
+                Edge* originalEdge = *itEdge;
+                subgrafo.addEdge(originalEdge->v1(), originalEdge->v2(), originalEdge->cost(), originalEdge->distance(), originalEdge->transport_type(), originalEdge->max_speed(), originalEdge->price_cost(), originalEdge->time_cost(), originalEdge->num_residencial(), originalEdge->num_commercial(), originalEdge->num_touristic(), originalEdge->num_industrial(), originalEdge->bus_preference());
             }
         }
     }
@@ -209,6 +239,21 @@ std::tuple<std::vector<Edge*>, int,  std::unordered_map<vertex, std::tuple<std::
 
     Kruskal::mstKruskalFast(solucao, subgrafo);
 
-    // Return the solution, total cost, and updated parentMap
-    return std::make_tuple(solucao, TotalCost, parentMap);
+    // mstKruskalFast devolve cópias alocadas com new: cada cópia é liberada e trocada pela aresta
+    // equivalente do grafo original, que continua sendo a dona dela (nullptr se não houver)
+    for (Edge*& edge : solucao) {
+        if (!edge) continue;
+        Edge* equivalente = nullptr;
+        for (Edge* original = graph.getEdges(edge->v1()); original; original = original->next()) {
+            if (original->v2() == edge->v2() && original->transport_type() == edge->transport_type()) {
+                equivalente = original;
+                break;
+            }
+        }
+        delete edge;
+        edge = equivalente;
+    }
+
+    // Return the solution, total cost, and the stations' shortest-path trees
+    return std::make_tuple(std::move(solucao), TotalCost, std::move(arvores));
 }
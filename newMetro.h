@@ -3,14 +3,25 @@
 
 #include "graph.h"
 #include "dataStructures.h"
+#include "sptStore.h"
 #include <tuple>
 
 std::vector<std::vector<vertex>> criarRegioes(Graph &g);
-std::tuple<std::vector<Edge*>, int,  std::unordered_map<vertex, std::tuple<std::vector<vertex>, std::vector<int>>>> escavacaoMetro(Graph& graph);
+// Retorna a MST do metrô (arestas do próprio graph, que não devem ser liberadas), o custo total
+// e as árvores de caminhos mínimos de cada estação
+std::tuple<std::vector<Edge*>, int, SptStore> escavacaoMetro(Graph& graph);
 
 class Dijkstra {
 public:
-    static void cptDijkstraFast(vertex v0, vertex* parent, int* distance, Graph& graph);
+    // parentEdge (opcional) recebe o id da aresta usada para chegar em cada vértice (-1 se não houver)
+    static void cptDijkstraFast(vertex v0, vertex* parent, int* distance, Graph& graph, int* parentEdge = nullptr);
+
+    // Atualiza um vetor de distâncias multi-fonte com uma nova fonte: a busca só avança por vértices
+    // cuja distância diminui, então o custo é proporcional à região que passa a ficar mais perto da nova fonte
+    static void updateMultiSource(vertex source, int* distance, Graph& graph);
+
+    // Retorna as arestas do caminho v0 -> target na ordem de percurso (vazio se target não foi alcançado)
+    static std::vector<Edge*> unpackPath(vertex v0, vertex target, const vertex* parent, const int* parentEdge, const Graph& graph);
 };
 
 class Kruskal {
@@ -0,0 +1,103 @@
+#ifndef PARETOBAGS_H
+#define PARETOBAGS_H
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "fastRoute.h"
+
+// Tolerância nas comparações de dinheiro e tempo: tarifas somadas em ordens diferentes podem diferir
+// no último bit (ex.: 13.2 + 0.8 != 14.0), e um orçamento de exatamente K deve aceitar a rota de custo K
+const double EPS_DINHEIRO = 1e-9;
+
+// Entrada da fila: ordem lexicográfica (chave, dinheiro) garante que um rótulo só é expandido
+// depois de todos os que poderiam dominá-lo. A chave é o tempo gasto, ou o tempo mais uma
+// estimativa consistente do tempo restante nas buscas A*.
+struct EntradaFila {
+    double tempo;
+    double dinheiro;
+    int32_t rotulo;
+
+    bool operator>(const EntradaFila& other) const {
+        if (tempo != other.tempo) return tempo > other.tempo;
+        if (dinheiro != other.dinheiro) return dinheiro > other.dinheiro;
+        return rotulo > other.rotulo;
+    }
+};
+
+// Pool de rótulos, fila e sacolas de Pareto por (vértice, modo) compartilhados pelas buscas
+// multimodais. reiniciar() limpa só os estados tocados, então a mesma instância pode ser
+// reaproveitada em várias buscas sem realocar.
+struct SacolasPareto {
+    std::vector<Rotulo> rotulos;
+    std::vector<EntradaFila> fila;  // Heap mínimo (std::push_heap com std::greater)
+    std::vector<int32_t> sacola;    // Cabeça da lista encadeada de cada estado vértice * NUM_MODOS + modo
+    std::vector<int32_t> tocados;   // Estados com sacola não vazia desde o último reinício
+
+    explicit SacolasPareto(int numVertices) : sacola((size_t)numVertices * NUM_MODOS, -1) {}
+
+    void reiniciar() {
+        for (int32_t estado : tocados) sacola[estado] = -1;
+        tocados.clear();
+        rotulos.clear();
+        fila.clear();
+    }
+
+    bool vazia() const { return fila.empty(); }
+
+    // Pool, fila e sacolas alocados (com folga) desde a criação
+    size_t bytes() const {
+        return rotulos.capacity() * sizeof(Rotulo) + fila.capacity() * sizeof(EntradaFila) +
+               sacola.capacity() * sizeof(int32_t) + tocados.capacity() * sizeof(int32_t);
+    }
+
+    // Remove da fila e retorna o índice do rótulo com menor chave
+    int32_t retirar() {
+        std::pop_heap(fila.begin(), fila.end(), std::greater<>());
+        int32_t rotulo = fila.back().rotulo;
+        fila.pop_back();
+        return rotulo;
+    }
+
+    // Tenta inserir um rótulo na sacola do seu estado; retorna false se ele for dominado
+    bool inserir(const Rotulo& novo, double chave) {
+        const double EPS = EPS_DINHEIRO;
+        size_t estado = (size_t)novo.atual * NUM_MODOS + novo.modoAtual;
+        int32_t anterior = -1;  // Rótulo anterior na sacola (-1 = cabeça)
+        int32_t r = sacola[estado];
+        while (r != -1) {
+            Rotulo& existente = rotulos[r];
+            if (existente.tempoGasto <= novo.tempoGasto + EPS && existente.dinheiroGasto <= novo.dinheiroGasto + EPS) {
+                return false;  // O novo rótulo é dominado
+            }
+            int32_t seguinte = existente.proximo;
+            if (novo.tempoGasto <= existente.tempoGasto + EPS && novo.dinheiroGasto <= existente.dinheiroGasto + EPS) {
+                // O novo domina o existente: sai da sacola e é ignorado quando sair da fila
+                existente.dominado = 1;
+                if (anterior == -1) sacola[estado] = seguinte; else rotulos[anterior].proximo = seguinte;
+            } else {
+                anterior = r;
+            }
+            r = seguinte;
+        }
+
+        // Insere no fim da sacola (o pool pode realocar no push_back, por isso só índices são guardados)
+        int32_t indice = rotulos.size();
+        rotulos.push_back(novo);
+        rotulos.back().proximo = -1;
+        if (anterior == -1) {
+            if (sacola[estado] == -1) tocados.push_back(estado);
+            sacola[estado] = indice;
+        } else {
+            rotulos[anterior].proximo = indice;
+        }
+        fila.push_back({chave, novo.dinheiroGasto, indice});
+        std::push_heap(fila.begin(), fila.end(), std::greater<>());
+        return true;
+    }
+
+    bool inserir(const Rotulo& novo) { return inserir(novo, novo.tempoGasto); }
+};
+
+#endif // PARETOBAGS_H
@@ -0,0 +1,102 @@
+#include "routeCache.h"
+#include <algorithm>
+#include <cmath>
+
+size_t HashChaveRota::operator()(const ChaveRota& chave) const {
+    // Mistura dos campos no estilo splitmix64
+    uint64_t h = ((uint64_t)(uint32_t)chave.origem << 32) | (uint32_t)chave.destino;
+    h ^= (uint64_t)chave.orcamentoCentavos * 0x9E3779B97F4A7C15ULL + chave.mascaraModos;
+    h ^= h >> 30; h *= 0xBF58476D1CE4E5B9ULL;
+    h ^= h >> 27; h *= 0x94D049BB133111EBULL;
+    h ^= h >> 31;
+    return (size_t)h;
+}
+
+RouteCache::RouteCache(size_t capacidade, int numParticoes) {
+    if (numParticoes < 1) numParticoes = 1;
+    m_capacidadeParticao = std::max<size_t>(1, capacidade / numParticoes);
+    for (int i = 0; i < numParticoes; ++i) {
+        m_particoes.emplace_back(new Particao());
+    }
+}
+
+namespace {
+// Nenhuma tarifa da cidade chega perto disso: orçamentos maiores equivalem a ilimitado e são
+// limitados a este valor, para que o valor em centavos caiba em long long
+const double ORCAMENTO_MAXIMO_CHAVE = 1e9;
+}  // namespace
+
+ChaveRota RouteCache::criarChave(vertex origem, vertex destino, double orcamento, uint8_t mascaraModos) {
+    if (!(orcamento > 0.0)) {
+        orcamento = 0.0;  // Negativo ou NaN
+    }
+    orcamento = std::min(orcamento, ORCAMENTO_MAXIMO_CHAVE);
+    return ChaveRota{origem, destino, std::llround(orcamento * 100.0), mascaraModos};
+}
+
+RouteCache::Resultado RouteCache::consultar(Graph& graph, vertex origem, vertex destino, double orcamento,
+                                            uint8_t mascaraModos) {
+    ChaveRota chave = criarChave(origem, destino, orcamento, mascaraModos);
+    size_t hash = HashChaveRota()(chave);
+    Particao& particao = *m_particoes[(hash >> 32) % m_particoes.size()];
+
+    {
+        std::lock_guard<std::mutex> lock(particao.mutex);
+        if (particao.grafo != graph.getId() || particao.versao != graph.getVersion()) {
+            // Outro grafo ou grafo alterado: as rotas guardadas não valem mais
+            particao.lru.clear();
+            particao.posicao.clear();
+            particao.grafo = graph.getId();
+            particao.versao = graph.getVersion();
+        }
+        auto it = particao.posicao.find(chave);
+        if (it != particao.posicao.end()) {
+            particao.lru.splice(particao.lru.begin(), particao.lru, it->second);
+            m_hits++;
+            return it->second->second;
+        }
+    }
+
+    // A busca roda fora do lock; duas threads com a mesma chave podem calcular a mesma rota,
+    // o que só custa tempo (a segunda apenas atualiza a entrada)
+    m_misses++;
+    unsigned long long versao = graph.getVersion();
+    Resultado resultado = obter_melhor_trajeto(graph, origem, destino, chave.orcamentoCentavos / 100.0, mascaraModos);
+
+    std::lock_guard<std::mutex> lock(particao.mutex);
+    if (particao.grafo != graph.getId() || particao.versao != versao) {
+        return resultado;  // O grafo mudou durante a busca: não guarda
+    }
+    auto it = particao.posicao.find(chave);
+    if (it != particao.posicao.end()) {
+        particao.lru.splice(particao.lru.begin(), particao.lru, it->second);
+        return resultado;
+    }
+    if (particao.lru.size() >= m_capacidadeParticao) {
+        particao.posicao.erase(particao.lru.back().first);
+        particao.lru.pop_back();
+    }
+    particao.lru.emplace_front(chave, resultado);
+    particao.posicao[chave] = particao.lru.begin();
+    return resultado;
+}
+
+void RouteCache::limpar() {
+    for (auto& particao : m_particoes) {
+        std::lock_guard<std::mutex> lock(particao->mutex);
+        particao->lru.clear();
+        particao->posicao.clear();
+        particao->grafo = 0;
+    }
+    m_hits = 0;
+    m_misses = 0;
+}
+
+size_t RouteCache::tamanho() const {
+    size_t total = 0;
+    for (const auto& particao : m_particoes) {
+        std::lock_guard<std::mutex> lock(particao->mutex);
+        total += particao->lru.size();
+    }
+    return total;
+}
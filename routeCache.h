@@ -0,0 +1,76 @@
+#ifndef ROUTECACHE_H
+#define ROUTECACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "graph.h"
+#include "fastRoute.h"
+
+// Chave de uma consulta de rota. O orçamento entra em centavos: orçamentos que arredondam
+// para o mesmo centavo compartilham a resposta. Orçamentos muito grandes são limitados antes
+// do arredondamento (ver criarChave).
+struct ChaveRota {
+    vertex origem;
+    vertex destino;
+    long long orcamentoCentavos;
+    uint8_t mascaraModos;
+
+    bool operator==(const ChaveRota& other) const {
+        return origem == other.origem && destino == other.destino &&
+               orcamentoCentavos == other.orcamentoCentavos && mascaraModos == other.mascaraModos;
+    }
+};
+
+struct HashChaveRota {
+    size_t operator()(const ChaveRota& chave) const;
+};
+
+// Cache LRU de resultados de obter_melhor_trajeto, seguro para várias threads.
+// As entradas são divididas em partições, cada uma com seu mutex e sua lista LRU, para que
+// threads consultando pares diferentes raramente disputem o mesmo lock. Cada partição guarda
+// o id e a versão do grafo em que suas entradas foram calculadas: qualquer addEdge/removeEdge muda
+// a versão e a partição é esvaziada no próximo acesso.
+class RouteCache {
+public:
+    typedef std::pair<std::vector<vertex>, double> Resultado;
+
+    explicit RouteCache(size_t capacidade = 1 << 16, int numParticoes = 16);
+
+    // Resultado da consulta, calculado com obter_melhor_trajeto só se ainda não estiver no cache
+    Resultado consultar(Graph& graph, vertex origem, vertex destino, double orcamento,
+                        uint8_t mascaraModos = TODOS_OS_MODOS);
+
+    void limpar();
+
+    long long getHits() const { return m_hits; }
+    long long getMisses() const { return m_misses; }
+    double taxaAcerto() const {
+        long long total = m_hits + m_misses;
+        return total ? (double)m_hits / total : 0.0;
+    }
+    size_t tamanho() const;
+
+private:
+    struct Particao {
+        std::mutex mutex;
+        unsigned long long grafo = 0;  // Graph::getId() (0 = nenhum)
+        unsigned long long versao = 0;
+        std::list<std::pair<ChaveRota, Resultado>> lru;  // Da mais recente para a menos recente
+        std::unordered_map<ChaveRota, std::list<std::pair<ChaveRota, Resultado>>::iterator, HashChaveRota> posicao;
+    };
+
+    static ChaveRota criarChave(vertex origem, vertex destino, double orcamento, uint8_t mascaraModos);
+
+    size_t m_capacidadeParticao;
+    std::vector<std::unique_ptr<Particao>> m_particoes;
+    std::atomic<long long> m_hits{0};
+    std::atomic<long long> m_misses{0};
+};
+
+#endif // ROUTECACHE_H
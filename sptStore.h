@@ -0,0 +1,156 @@
+#ifndef SPTSTORE_H
+#define SPTSTORE_H
+
+#include <vector>
+#include <limits>
+#include <climits>
+#include <cstddef>
+#include <algorithm>
+#include <unordered_map>
+#include "graph.h"
+
+// Visão somente leitura de uma árvore de caminhos mínimos guardada no SptStore
+template <typename DistT>
+struct SptView {
+    vertex source;
+    const vertex* parent;      // Pai de cada vértice (-1 se não alcançado)
+    const int* parentEdge;     // Id da aresta pai de cada vértice (-1 se não houver)
+    const DistT* distance;     // Distância até cada vértice (unreachable() se não alcançado)
+};
+
+// Armazena as árvores de caminhos mínimos de várias origens em blocos contíguos.
+// Cada árvore ocupa um slot: a linha [slot * V, (slot + 1) * V) de cada matriz.
+// O store só pode ser movido, nunca copiado, para que as árvores sejam compartilhadas
+// por referência entre metrô, ônibus e roteamento.
+template <typename DistT>
+class BasicSptStore {
+public:
+    explicit BasicSptStore(int numVertices) : m_numVertices(numVertices) {}
+
+    BasicSptStore(const BasicSptStore&) = delete;
+    BasicSptStore& operator=(const BasicSptStore&) = delete;
+    BasicSptStore(BasicSptStore&&) = default;
+    BasicSptStore& operator=(BasicSptStore&&) = default;
+
+    // Valor usado para vértices não alcançados (INT_MAX quando DistT é int, como no Dijkstra)
+    static constexpr DistT unreachable() { return std::numeric_limits<DistT>::max(); }
+
+    // Reserva um slot, reaproveitando um liberado antes de crescer as matrizes
+    int acquireSlot() {
+        if (!m_freeSlots.empty()) {
+            int slot = m_freeSlots.back();
+            m_freeSlots.pop_back();
+            return slot;
+        }
+        int slot = m_numSlots++;
+        size_t size = static_cast<size_t>(m_numSlots) * m_numVertices;
+        m_parent.resize(size, -1);
+        m_parentEdge.resize(size, -1);
+        m_distance.resize(size, unreachable());
+        m_slotSource.push_back(-1);
+        return slot;
+    }
+
+    // Libera o slot (e desassocia a origem ligada a ele, se houver)
+    void releaseSlot(int slot) {
+        vertex source = m_slotSource[slot];
+        if (source != -1) {
+            m_slotOf.erase(source);
+            for (size_t i = 0; i < m_sources.size(); ++i) {
+                if (m_sources[i] == source) {
+                    m_sources.erase(m_sources.begin() + i);
+                    break;
+                }
+            }
+            m_slotSource[slot] = -1;
+        }
+        m_freeSlots.push_back(slot);
+    }
+
+    // Associa a árvore guardada no slot à sua origem
+    void bind(vertex source, int slot) {
+        m_slotOf[source] = slot;
+        m_slotSource[slot] = source;
+        m_sources.push_back(source);
+    }
+
+    // Slot da árvore com essa origem (-1 se não existir)
+    int find(vertex source) const {
+        auto it = m_slotOf.find(source);
+        return it != m_slotOf.end() ? it->second : -1;
+    }
+
+    vertex* parent(int slot) { return m_parent.data() + offset(slot); }
+    int* parentEdge(int slot) { return m_parentEdge.data() + offset(slot); }
+    DistT* distance(int slot) { return m_distance.data() + offset(slot); }
+    const vertex* parent(int slot) const { return m_parent.data() + offset(slot); }
+    const int* parentEdge(int slot) const { return m_parentEdge.data() + offset(slot); }
+    const DistT* distance(int slot) const { return m_distance.data() + offset(slot); }
+
+    SptView<DistT> view(int slot) const {
+        return SptView<DistT>{m_slotSource[slot], parent(slot), parentEdge(slot), distance(slot)};
+    }
+
+    // Origens associadas, na ordem em que foram ligadas
+    const std::vector<vertex>& sources() const { return m_sources; }
+    int getNumVertices() const { return m_numVertices; }
+    int getNumSlots() const { return m_numSlots; }
+
+    // Bytes ocupados pelas matrizes das árvores
+    size_t bytes() const {
+        return m_parent.capacity() * sizeof(vertex) + m_parentEdge.capacity() * sizeof(int) +
+               m_distance.capacity() * sizeof(DistT);
+    }
+
+    // Verifica se todas as distâncias alcançadas cabem em NarrowT (reservando o máximo para "não alcançado")
+    template <typename NarrowT>
+    bool fitsIn() const {
+        for (DistT d : m_distance) {
+            if (d != unreachable() && static_cast<long long>(d) >= static_cast<long long>(std::numeric_limits<NarrowT>::max())) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Converte as distâncias para um tipo mais estreito (ex.: uint16_t); só use depois de fitsIn<NarrowT>()
+    template <typename NarrowT>
+    BasicSptStore<NarrowT> narrow() const {
+        BasicSptStore<NarrowT> result(m_numVertices);
+        for (int slot = 0; slot < m_numSlots; ++slot) {
+            int newSlot = result.acquireSlot();
+            std::copy(parent(slot), parent(slot) + m_numVertices, result.parent(newSlot));
+            std::copy(parentEdge(slot), parentEdge(slot) + m_numVertices, result.parentEdge(newSlot));
+            const DistT* src = distance(slot);
+            NarrowT* dst = result.distance(newSlot);
+            for (int v = 0; v < m_numVertices; ++v) {
+                dst[v] = (src[v] == unreachable()) ? BasicSptStore<NarrowT>::unreachable() : static_cast<NarrowT>(src[v]);
+            }
+        }
+        for (vertex source : m_sources) {
+            result.bind(source, find(source));
+        }
+        for (int slot : m_freeSlots) {
+            result.releaseSlot(slot);
+        }
+        return result;
+    }
+
+private:
+    size_t offset(int slot) const { return static_cast<size_t>(slot) * m_numVertices; }
+
+    int m_numVertices;
+    int m_numSlots = 0;
+    std::vector<vertex> m_parent;       // Matriz slots x V de pais
+    std::vector<int> m_parentEdge;      // Matriz slots x V de ids de aresta pai
+    std::vector<DistT> m_distance;      // Matriz slots x V de distâncias
+    std::vector<vertex> m_slotSource;   // Origem ligada a cada slot (-1 se livre)
+    std::vector<int> m_freeSlots;       // Slots liberados para reaproveitamento
+    std::unordered_map<vertex, int> m_slotOf;  // Origem -> slot
+    std::vector<vertex> m_sources;      // Origens na ordem de inserção
+};
+
+// Store padrão: distâncias em int, compatível com Dijkstra::cptDijkstraFast
+typedef BasicSptStore<int> SptStore;
+
+#endif // SPTSTORE_H
@@ -0,0 +1,55 @@
+#include "ssspCache.h"
+#include "newMetro.h"
+
+SptView<int> SsspCache::consultar(Graph& graph, vertex origem) {
+    validar(graph);
+
+    auto it = m_posicaoLru.find(origem);
+    if (it != m_posicaoLru.end()) {
+        // Acerto: move a origem para o início da lista LRU
+        m_lru.splice(m_lru.begin(), m_lru, it->second);
+        m_hits++;
+        return m_arvores->view(m_arvores->find(origem));
+    }
+
+    m_misses++;
+
+    // Cache cheio: descarta a origem usada há mais tempo e reaproveita o slot dela
+    if ((int)m_lru.size() >= m_capacidade) {
+        vertex antiga = m_lru.back();
+        m_lru.pop_back();
+        m_posicaoLru.erase(antiga);
+        m_arvores->releaseSlot(m_arvores->find(antiga));
+    }
+
+    int slot = m_arvores->acquireSlot();
+    Dijkstra::cptDijkstraFast(origem, m_arvores->parent(slot), m_arvores->distance(slot), graph, m_arvores->parentEdge(slot));
+    m_arvores->bind(origem, slot);
+
+    m_lru.push_front(origem);
+    m_posicaoLru[origem] = m_lru.begin();
+    return m_arvores->view(slot);
+}
+
+void SsspCache::limpar() {
+    m_arvores.reset();
+    m_lru.clear();
+    m_posicaoLru.clear();
+    m_grafo = 0;
+}
+
+void SsspCache::validar(const Graph& graph) {
+    if (m_grafo == graph.getId() && m_versao == graph.getVersion() && m_arvores) {
+        return;
+    }
+    // Outro grafo ou grafo alterado: as árvores guardadas não valem mais
+    limpar();
+    m_grafo = graph.getId();
+    m_versao = graph.getVersion();
+    m_arvores.reset(new SptStore(graph.getNumVertices()));
+}
+
+SsspCache& SsspCache::compartilhado() {
+    static SsspCache cache;
+    return cache;
+}
@@ -0,0 +1,50 @@
+#ifndef SSSPCACHE_H
+#define SSSPCACHE_H
+
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include "graph.h"
+#include "sptStore.h"
+
+// Cache LRU limitado de árvores de caminhos mínimos (Dijkstra por distância), indexado pela origem.
+// As árvores ficam em um SptStore com no máximo `capacidade` slots; quando o cache enche,
+// a origem usada há mais tempo é descartada. Qualquer mudança no grafo (versão diferente)
+// ou a consulta com outro grafo (id diferente) esvazia o cache. Não é thread-safe.
+class SsspCache {
+public:
+    explicit SsspCache(int capacidade = 32) : m_capacidade(capacidade > 0 ? capacidade : 1) {}
+
+    // Árvore a partir de origem, calculada na primeira consulta.
+    // A visão só é válida até a próxima consulta ao cache.
+    SptView<int> consultar(Graph& graph, vertex origem);
+
+    // Distância mínima entre origem e destino (INT_MAX se não houver caminho)
+    int distancia(Graph& graph, vertex origem, vertex destino) {
+        return consultar(graph, origem).distance[destino];
+    }
+
+    void limpar();
+
+    long long getHits() const { return m_hits; }
+    long long getMisses() const { return m_misses; }
+    int getCapacidade() const { return m_capacidade; }
+    size_t bytes() const { return m_arvores ? m_arvores->bytes() : 0; }
+
+    // Cache compartilhado por calcularDistancia, bus3.cpp, bus.cpp e newMetro.cpp
+    static SsspCache& compartilhado();
+
+private:
+    void validar(const Graph& graph);
+
+    int m_capacidade;
+    unsigned long long m_grafo = 0;  // Graph::getId() (0 = nenhum)
+    unsigned long long m_versao = 0;
+    std::unique_ptr<SptStore> m_arvores;
+    std::list<vertex> m_lru;  // Origens da mais recente para a menos recente
+    std::unordered_map<vertex, std::list<vertex>::iterator> m_posicaoLru;
+    long long m_hits = 0;
+    long long m_misses = 0;
+};
+
+#endif // SSSPCACHE_H
@@ -0,0 +1,107 @@
+#include "stateGraph.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+StateGraph::StateGraph(const Graph& graph)
+    : m_idGrafo(graph.getId()), m_versao(graph.getVersion()), m_numVertices(graph.getNumVertices()) {
+    int numEstados = getNumEstados();
+
+    // Primeira passada: grau de cada vértice (cada estado de v tem um arco por aresta de v)
+    std::vector<int32_t> grau(m_numVertices, 0);
+    size_t totalArcos = 0;
+    for (vertex v = 0; v < m_numVertices; ++v) {
+        for (Edge* edge = graph.getEdges(v); edge; edge = edge->next()) {
+            grau[v]++;
+        }
+        totalArcos += (size_t)grau[v] * NUM_MODOS;
+    }
+
+    m_inicio.assign(numEstados + 1, 0);
+    m_destino.reserve(totalArcos);
+    m_tempo.reserve(totalArcos);
+    m_custo.reserve(totalArcos);
+    m_modoAresta.reserve(totalArcos);
+    m_arestaId.reserve(totalArcos);
+
+    for (vertex v = 0; v < m_numVertices; ++v) {
+        for (uint8_t modoAtual = 0; modoAtual < NUM_MODOS; ++modoAtual) {
+            m_inicio[estado(v, modoAtual)] = m_destino.size();
+            for (Edge* edge = graph.getEdges(v); edge; edge = edge->next()) {
+                ModoTransporte tipo = modoDaAresta(edge->transport_type());
+                vertex w = edge->otherVertex(v);
+                double tempoArco = 0.0;
+                double custoArco = 0.0;
+                uint8_t novoModo = modoAtual;
+
+                // Mesmas regras de tarifa da busca multimodal, aplicadas uma vez por arco
+                if (tipo == MODO_METRO || tipo == MODO_ONIBUS) {
+                    if (modoAtual != tipo) {
+                        custoArco = calcularCusto(*edge, tipo);
+                    }
+                    tempoArco = calcularTempo(*edge, tipo);
+                    novoModo = tipo;
+                } else if (tipo == MODO_TAXI) {
+                    custoArco = calcularCusto(*edge, MODO_TAXI);
+                    tempoArco = calcularTempo(*edge, MODO_TAXI);
+                    novoModo = MODO_TAXI;
+                    if (modoAtual != MODO_TAXI) {
+                        custoArco += 10.0;
+                    }
+                } else if (tipo == MODO_WALK) {
+                    tempoArco = calcularTempo(*edge, MODO_WALK);
+                    novoModo = MODO_WALK;
+                }
+
+                m_destino.push_back(estado(w, novoModo));
+                m_tempo.push_back(tempoArco);
+                m_custo.push_back(custoArco);
+                m_modoAresta.push_back(tipo);
+                m_arestaId.push_back(edge->id());
+            }
+        }
+    }
+    m_inicio[numEstados] = m_destino.size();
+}
+
+size_t StateGraph::bytes() const {
+    return m_inicio.capacity() * sizeof(int32_t) + m_destino.capacity() * sizeof(int32_t) +
+           m_tempo.capacity() * sizeof(double) + m_custo.capacity() * sizeof(double) +
+           m_modoAresta.capacity() * sizeof(uint8_t) + m_arestaId.capacity() * sizeof(int32_t);
+}
+
+namespace {
+// Slots de grafos compilados indexados pelo id do grafo (grafos que caem no mesmo slot só se
+// revezam, recompilando). Lidos e trocados com as operações atômicas de shared_ptr.
+const size_t NUM_SLOTS_COMPILADOS = 8;
+std::shared_ptr<const StateGraph> slotsCompilados[NUM_SLOTS_COMPILADOS];
+std::shared_ptr<const StateGraph> compiladoAtualGlobal;  // Último compilado (relatório de memória)
+std::mutex mutexCompilado;
+
+bool valePara(const std::shared_ptr<const StateGraph>& estados, const Graph& graph) {
+    return estados && estados->getIdGrafo() == graph.getId() && estados->getVersao() == graph.getVersion();
+}
+}  // namespace
+
+std::shared_ptr<const StateGraph> StateGraph::compilado(const Graph& graph) {
+    std::shared_ptr<const StateGraph>& slot = slotsCompilados[graph.getId() % NUM_SLOTS_COMPILADOS];
+    std::shared_ptr<const StateGraph> atual = std::atomic_load(&slot);
+    if (valePara(atual, graph)) {
+        return atual;
+    }
+
+    // Outro grafo ou grafo alterado: recompila (quem ainda usa a versão anterior a mantém viva).
+    // O mutex evita que várias threads compilem a mesma versão ao mesmo tempo.
+    std::lock_guard<std::mutex> lock(mutexCompilado);
+    atual = std::atomic_load(&slot);
+    if (!valePara(atual, graph)) {
+        atual = std::make_shared<const StateGraph>(graph);
+        std::atomic_store(&slot, atual);
+        std::atomic_store(&compiladoAtualGlobal, atual);
+    }
+    return atual;
+}
+
+std::shared_ptr<const StateGraph> StateGraph::compiladoAtual() {
+    return std::atomic_load(&compiladoAtualGlobal);
+}
@@ -0,0 +1,65 @@
+#ifndef STATEGRAPH_H
+#define STATEGRAPH_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "graph.h"
+#include "fastRoute.h"
+
+// Grafo de estados multimodal compilado a partir do Graph: o estado v * NUM_MODOS + modo
+// é "estar em v tendo chegado por modo". Cada aresta do Graph vira um arco saindo de cada
+// camada, já com o tempo e o custo da transição (passagem de metrô/ônibus ao embarcar,
+// bandeirada do taxi ao entrar nele), de modo que a busca não consulta mais strings nem regras
+// de tarifa. Arestas de tipo desconhecido ficam em todas as camadas com tempo e custo zero,
+// sem trocar o modo. Os arcos ficam em formato CSR (arrays contíguos por estado de origem).
+class StateGraph {
+public:
+    explicit StateGraph(const Graph& graph);
+
+    int getNumVertices() const { return m_numVertices; }
+    int getNumEstados() const { return m_numVertices * NUM_MODOS; }
+    size_t getNumArcos() const { return m_destino.size(); }
+    unsigned long long getVersao() const { return m_versao; }
+    unsigned long long getIdGrafo() const { return m_idGrafo; }  // Graph::getId() do grafo de origem
+
+    static int estado(vertex v, uint8_t modo) { return v * NUM_MODOS + modo; }
+    static vertex verticeDe(int estado) { return estado / NUM_MODOS; }
+    static uint8_t modoDe(int estado) { return estado % NUM_MODOS; }
+
+    // Arcos do estado s: índices [inicio(s), fim(s))
+    int32_t inicio(int s) const { return m_inicio[s]; }
+    int32_t fim(int s) const { return m_inicio[s + 1]; }
+    int32_t destino(int32_t arco) const { return m_destino[arco]; }
+    double tempo(int32_t arco) const { return m_tempo[arco]; }
+    double custo(int32_t arco) const { return m_custo[arco]; }
+    uint8_t modoAresta(int32_t arco) const { return m_modoAresta[arco]; }  // ModoTransporte da aresta original
+    int32_t arestaId(int32_t arco) const { return m_arestaId[arco]; }      // Edge::id() da aresta original
+
+    // O arco pode ser usado com a máscara de modos da consulta?
+    bool permitido(int32_t arco, uint8_t mascaraModos) const {
+        return m_modoAresta[arco] == MODO_DESCONHECIDO || (mascaraModos & (1 << m_modoAresta[arco]));
+    }
+
+    size_t bytes() const;
+
+    // Grafo de estados do Graph na versão atual, compilado só quando o grafo muda.
+    // Seguro para várias threads; a instância devolvida continua válida enquanto for usada.
+    // Cada grafo tem um slot (pelo id) lido sem lock; o mutex só é usado para compilar.
+    static std::shared_ptr<const StateGraph> compilado(const Graph& graph);
+    // Último grafo de estados compilado, sem compilar nada (nullptr se ainda não houver)
+    static std::shared_ptr<const StateGraph> compiladoAtual();
+
+private:
+    unsigned long long m_idGrafo;
+    unsigned long long m_versao;
+    int m_numVertices;
+    std::vector<int32_t> m_inicio;
+    std::vector<int32_t> m_destino;
+    std::vector<double> m_tempo;
+    std::vector<double> m_custo;
+    std::vector<uint8_t> m_modoAresta;
+    std::vector<int32_t> m_arestaId;
+};
+
+#endif // STATEGRAPH_H
@@ -0,0 +1,66 @@
+#include "stats.h"
+
+Estatisticas& Estatisticas::global() {
+    static Estatisticas estatisticas;
+    return estatisticas;
+}
+
+void Estatisticas::registrarFase(const std::string& nome, double segundos) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (Fase& fase : m_fases) {
+        if (fase.nome == nome) {
+            fase.chamadas++;
+            fase.segundos += segundos;
+            return;
+        }
+    }
+    m_fases.push_back({nome, 1, segundos});
+}
+
+void Estatisticas::registrarBusca(const std::string& tipo, const ContadoresBusca& contadores) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (Busca& busca : m_buscas) {
+        if (busca.tipo == tipo) {
+            busca.contadores.somar(contadores);
+            return;
+        }
+    }
+    m_buscas.push_back({tipo, contadores});
+}
+
+void Estatisticas::limpar() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_fases.clear();
+    m_buscas.clear();
+}
+
+ContadoresBusca Estatisticas::totalBuscas() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ContadoresBusca total;
+    for (const Busca& busca : m_buscas) {
+        total.somar(busca.contadores);
+    }
+    return total;
+}
+
+nlohmann::json Estatisticas::relatorio() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    nlohmann::json relatorio;
+#ifndef PAA_SEM_ESTATISTICAS
+    relatorio["enabled"] = true;
+#else
+    relatorio["enabled"] = false;
+#endif
+    relatorio["phases"] = nlohmann::json::array();
+    for (const Fase& fase : m_fases) {
+        relatorio["phases"].push_back({{"name", fase.nome}, {"calls", fase.chamadas}, {"total_ms", fase.segundos * 1000}});
+    }
+    relatorio["searches"] = nlohmann::json::object();
+    for (const Busca& busca : m_buscas) {
+        const ContadoresBusca& c = busca.contadores;
+        relatorio["searches"][busca.tipo] = {{"searches", c.buscas}, {"pushes", c.insercoes}, {"decrease_keys", c.reducoes},
+                                             {"settled", c.assentados}, {"relaxed", c.relaxadas},
+                                             {"peak_bytes", c.picoBytes}};
+    }
+    return relatorio;
+}
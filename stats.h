@@ -0,0 +1,98 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "external/json.hpp"
+
+// Instrumentação leve: fases cronometradas e contadores das buscas, somados em um registro global
+// e exportados em JSON (main --stats). Compilar com -DPAA_SEM_ESTATISTICAS remove todas as
+// medições: as macros abaixo viram nada e o relatório só informa que elas estão desligadas.
+
+// Contadores de uma busca. Cada busca conta em uma instância local e soma no registro ao terminar,
+// então o laço interno não toca em memória compartilhada.
+struct ContadoresBusca {
+    uint64_t buscas = 0;
+    uint64_t insercoes = 0;    // Entradas colocadas na fila
+    uint64_t reducoes = 0;     // Reduções de chave (na fila preguiçosa, reinserções de um vértice já alcançado)
+    uint64_t assentados = 0;   // Vértices (ou rótulos) retirados da fila e expandidos
+    uint64_t relaxadas = 0;    // Arestas examinadas a partir dos expandidos
+    uint64_t picoBytes = 0;    // Maior memória de trabalho (fila, rótulos) de uma busca
+
+    void somar(const ContadoresBusca& outro) {
+        buscas += outro.buscas;
+        insercoes += outro.insercoes;
+        reducoes += outro.reducoes;
+        assentados += outro.assentados;
+        relaxadas += outro.relaxadas;
+        picoBytes = std::max(picoBytes, outro.picoBytes);
+    }
+};
+
+// Registro global das fases e buscas. Seguro para várias threads.
+class Estatisticas {
+public:
+    static Estatisticas& global();
+
+    void registrarFase(const std::string& nome, double segundos);
+    void registrarBusca(const std::string& tipo, const ContadoresBusca& contadores);
+    void limpar();
+
+    // Soma dos contadores de todos os tipos de busca registrados até agora
+    ContadoresBusca totalBuscas() const;
+
+    // {"enabled", "phases": [{"name", "calls", "total_ms"}], "searches": {tipo: {...}}}
+    nlohmann::json relatorio() const;
+
+private:
+    struct Fase {
+        std::string nome;
+        uint64_t chamadas = 0;
+        double segundos = 0;
+    };
+    struct Busca {
+        std::string tipo;
+        ContadoresBusca contadores;
+    };
+
+    mutable std::mutex m_mutex;
+    std::vector<Fase> m_fases;    // Na ordem da primeira execução
+    std::vector<Busca> m_buscas;
+};
+
+// Cronometra do construtor até parar() ou o fim do escopo
+class FaseCronometrada {
+public:
+    explicit FaseCronometrada(const char* nome) : m_nome(nome), m_inicio(std::chrono::steady_clock::now()) {}
+    ~FaseCronometrada() { parar(); }
+
+    void parar() {
+        if (!m_nome) return;
+        Estatisticas::global().registrarFase(m_nome, std::chrono::duration<double>(std::chrono::steady_clock::now() - m_inicio).count());
+        m_nome = nullptr;
+    }
+
+private:
+    const char* m_nome;
+    std::chrono::steady_clock::time_point m_inicio;
+};
+
+#ifndef PAA_SEM_ESTATISTICAS
+#define ESTAT_FASE(variavel, nome) FaseCronometrada variavel(nome)
+#define ESTAT_FIM(variavel) variavel.parar()
+#define ESTAT_CONTAR(contadores, campo) (++(contadores).campo)
+#define ESTAT_PICO_BYTES(contadores, bytes) ((contadores).picoBytes = std::max<uint64_t>((contadores).picoBytes, (bytes)))
+#define ESTAT_REGISTRAR_BUSCA(tipo, contadores) Estatisticas::global().registrarBusca(tipo, contadores)
+#else
+#define ESTAT_FASE(variavel, nome) ((void)0)
+#define ESTAT_FIM(variavel) ((void)0)
+#define ESTAT_CONTAR(contadores, campo) ((void)(contadores))
+#define ESTAT_PICO_BYTES(contadores, bytes) ((void)(contadores))
+#define ESTAT_REGISTRAR_BUSCA(tipo, contadores) ((void)(contadores))
+#endif
+
+#endif // STATS_H
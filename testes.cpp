@@ -0,0 +1,117 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include "graph.h"
+#include "fastRoute.h"
+#include "kShortest.h"
+#include "routeCache.h"
+#include "batchRoutes.h"
+#include "travelProfiles.h"
+#include "trafficAssignment.h"
+
+// Testes de regressão das buscas de rota em grafos pequenos montados à mão.
+// Compilação: g++ -std=c++17 -O2 -pthread testes.cpp Graph.cpp kShortest.cpp fastestRouteQ3.cpp stateGraph.cpp
+//             travelProfiles.cpp stats.cpp routeCache.cpp batchRoutes.cpp trafficAssignment.cpp -o testes
+// Uso: testes (código de saída 1 se algum teste falhar)
+
+namespace {
+
+int falhas = 0;
+
+void verificar(bool condicao, const std::string& descricao) {
+    if (!condicao) {
+        std::cerr << "FALHOU: " << descricao << std::endl;
+        falhas++;
+    }
+}
+
+// Rua nos dois sentidos, com uma aresta por tipo de transporte (como em loadFromJSON)
+void adicionarRua(Graph& graph, vertex v1, vertex v2, int distancia, const std::vector<std::string>& tipos) {
+    for (const std::string& tipo : tipos) {
+        graph.addEdge(v1, v2, 0, distancia, tipo, 0, 1, 0, 0, 0, 0, 0, 0);
+        graph.addEdge(v2, v1, 0, distancia, tipo, 0, 1, 0, 0, 0, 0, 0, 0);
+    }
+}
+
+// Duas rotas de 0 a 2, cada rua com caminhada e taxi em paralelo: 0-1-2 (100 m) e 0-3-2 (3000 m).
+// Um desvio que só troca o modo de 0-1-2 não pode esconder a rota por 3.
+void testeAlternativasComModosParalelos() {
+    Graph graph(4);
+    adicionarRua(graph, 0, 1, 50, {"walk", "taxi"});
+    adicionarRua(graph, 1, 2, 50, {"walk", "taxi"});
+    adicionarRua(graph, 0, 3, 1500, {"walk", "taxi"});
+    adicionarRua(graph, 3, 2, 1500, {"walk", "taxi"});
+
+    std::vector<std::pair<std::vector<vertex>, int>> caminhos = k_caminhos_mais_curtos(graph, 0, 2, 3);
+    verificar(caminhos.size() == 2, "k_caminhos_mais_curtos acha as 2 rotas");
+    verificar(caminhos.size() == 2 && caminhos[0].first == std::vector<vertex>({0, 1, 2}) && caminhos[0].second == 100,
+              "k_caminhos_mais_curtos: primeira rota 0-1-2 com 100 m");
+    verificar(caminhos.size() == 2 && caminhos[1].first == std::vector<vertex>({0, 3, 2}) && caminhos[1].second == 3000,
+              "k_caminhos_mais_curtos: segunda rota 0-3-2 com 3000 m");
+
+    std::vector<RotaPareto> rotas = k_rotas_mais_rapidas(graph, 0, 2, 1000, 3);
+    verificar(rotas.size() == 2, "k_rotas_mais_rapidas acha as 2 rotas com caminhada e taxi em paralelo");
+    verificar(rotas.size() == 2 && rotas[0].caminho == std::vector<vertex>({0, 1, 2}), "k_rotas_mais_rapidas: primeira rota 0-1-2");
+    verificar(rotas.size() == 2 && rotas[1].caminho == std::vector<vertex>({0, 3, 2}), "k_rotas_mais_rapidas: segunda rota 0-3-2");
+    verificar(rotas.size() == 2 && rotas[0].tempo <= rotas[1].tempo, "k_rotas_mais_rapidas em ordem de tempo");
+
+    // A primeira alternativa é a própria rota mais rápida
+    std::pair<std::vector<vertex>, double> melhor = obter_melhor_trajeto(graph, 0, 2, 1000);
+    verificar(!rotas.empty() && rotas[0].tempo == melhor.second, "k_rotas_mais_rapidas começa pela rota de obter_melhor_trajeto");
+}
+
+// Um orçamento enorme é o mesmo que ilimitado: a rota do cache tem que ser a mesma de um orçamento
+// que já paga qualquer trajeto, e não "sem rota" por estouro no valor em centavos
+void testeOrcamentoGrandeNoCache() {
+    Graph graph(3);
+    adicionarRua(graph, 0, 1, 2000, {"walk", "taxi"});
+    adicionarRua(graph, 1, 2, 2000, {"walk", "taxi"});
+
+    RouteCache cache;
+    RouteCache::Resultado normal = cache.consultar(graph, 0, 2, 1000);
+    RouteCache::Resultado enorme = cache.consultar(graph, 0, 2, 1e20);
+    verificar(!normal.first.empty(), "RouteCache acha a rota com orçamento 1000");
+    verificar(enorme.first == normal.first && enorme.second == normal.second,
+              "RouteCache: orçamento 1e20 dá a mesma rota que 1000");
+
+    ConsultaRota grande = lerConsultaRota("{\"origin\": 0, \"destination\": 2, \"budget\": 1e20}", graph);
+    verificar(grande.erro.empty(), "lerConsultaRota aceita orçamento 1e20");
+    ConsultaRota negativa = lerConsultaRota("{\"origin\": 0, \"destination\": 2, \"budget\": -1}", graph);
+    verificar(!negativa.erro.empty(), "lerConsultaRota rejeita orçamento negativo");
+}
+
+// Um perfil com queda brusca só respeita FIFO em arestas rápidas: quando o tempo congestionado deixa
+// a aresta lenta demais, o perfil tem que sair dela
+void testeFifoDepoisDoCongestionamento() {
+    Graph graph(2);
+    graph.addEdge(0, 1, 0, 100, "taxi", 0, 1, 10, 0, 0, 0, 0, 0);  // 10 s
+    int id = graph.getEdges(0)->id();
+
+    TravelProfiles perfis;
+    int queda = perfis.adicionarPerfil({{0, 1.0}, {480, 5.0}, {481, 1.0}});  // Fator cai 4 por minuto
+    verificar(perfis.atribuir(graph, id, queda), "perfil respeita FIFO com 10 s de base");
+
+    ResultadoAtribuicao resultado;
+    resultado.tempo.assign(graph.getNumEdgeIds(), 10);
+    aplicarTemposCongestionados(graph, resultado, &perfis);
+    verificar(perfis.perfilDaAresta(id) == queda, "tempo inalterado mantém o perfil");
+
+    resultado.tempo[id] = 60;  // 1 min * -4 por minuto < -1
+    aplicarTemposCongestionados(graph, resultado, &perfis);
+    verificar(perfis.perfilDaAresta(id) == -1, "aplicarTemposCongestionados tira o perfil que passou a violar FIFO");
+}
+
+} // namespace
+
+int main() {
+    testeAlternativasComModosParalelos();
+    testeOrcamentoGrandeNoCache();
+    testeFifoDepoisDoCongestionamento();
+
+    if (falhas > 0) {
+        std::cerr << falhas << " verificação(ões) falharam" << std::endl;
+        return 1;
+    }
+    std::cout << "Todos os testes passaram" << std::endl;
+    return 0;
+}
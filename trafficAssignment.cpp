@@ -0,0 +1,245 @@
+#include "trafficAssignment.h"
+#include "stats.h"
+#include "travelProfiles.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+namespace {
+
+// Rede de veículos em CSR. Arestas paralelas iguais (o loader guarda cada rua mais de uma vez)
+// viram um arco só; arestas guarda os ids de cada arco.
+struct RedeAtribuicao {
+    std::vector<int32_t> inicio;
+    std::vector<vertex> origem;
+    std::vector<vertex> destino;
+    std::vector<double> tempoLivre;
+    std::vector<std::vector<int>> arestas;
+
+    RedeAtribuicao(const Graph& graph, const std::string& transporte) {
+        int numVertices = graph.getNumVertices();
+        inicio.assign(numVertices + 1, 0);
+        std::vector<std::pair<vertex, Edge*>> vizinhos;
+        for (vertex v = 0; v < numVertices; ++v) {
+            vizinhos.clear();
+            for (Edge* edge = graph.getEdges(v); edge; edge = edge->next()) {
+                if (edge->transport_type() == transporte) vizinhos.push_back({edge->v2(), edge});
+            }
+            std::stable_sort(vizinhos.begin(), vizinhos.end(),
+                             [](const auto& a, const auto& b) { return a.first < b.first; });
+            for (size_t i = 0; i < vizinhos.size(); ++i) {
+                if (i == 0 || vizinhos[i].first != vizinhos[i - 1].first) {
+                    origem.push_back(v);
+                    destino.push_back(vizinhos[i].first);
+                    tempoLivre.push_back(vizinhos[i].second->time_cost());
+                    arestas.emplace_back();
+                }
+                arestas.back().push_back(vizinhos[i].second->id());
+            }
+            inicio[v + 1] = destino.size();
+        }
+    }
+
+    int numArcos() const { return destino.size(); }
+};
+
+// Demanda agrupada por origem: destinos de origens[i] em [inicio[i], inicio[i + 1])
+struct DemandaPorOrigem {
+    std::vector<vertex> origens;
+    std::vector<int32_t> inicio;
+    std::vector<vertex> destino;
+    std::vector<double> volume;
+
+    DemandaPorOrigem(const std::vector<ViagemOD>& viagens, int numVertices, double volumeViagem) {
+        std::vector<std::pair<vertex, vertex>> pares;
+        for (const ViagemOD& viagem : viagens) {
+            if (viagem.origem < 0 || viagem.destino < 0 || viagem.origem >= numVertices ||
+                viagem.destino >= numVertices || viagem.origem == viagem.destino) continue;
+            pares.push_back({viagem.origem, viagem.destino});
+        }
+        std::sort(pares.begin(), pares.end());
+        for (size_t i = 0; i < pares.size(); ++i) {
+            if (i > 0 && pares[i] == pares[i - 1]) {
+                volume.back() += volumeViagem;
+                continue;
+            }
+            if (origens.empty() || origens.back() != pares[i].first) {
+                origens.push_back(pares[i].first);
+                inicio.push_back(destino.size());
+            }
+            destino.push_back(pares[i].second);
+            volume.push_back(volumeViagem);
+        }
+        inicio.push_back(destino.size());
+    }
+};
+
+// Tudo-ou-nada: carrega cada origem na sua árvore de caminhos mínimos com os tempos dados.
+// Retorna o volume que não encontrou caminho.
+double tudoOuNada(const RedeAtribuicao& rede, const DemandaPorOrigem& demanda, const std::vector<double>& tempo,
+                  int numThreads, std::vector<double>& fluxo) {
+    const int numVertices = rede.inicio.size() - 1;
+    const double INF = std::numeric_limits<double>::infinity();
+    std::fill(fluxo.begin(), fluxo.end(), 0.0);
+    std::atomic<size_t> proxima(0);
+    std::mutex mutexFluxo;
+    double semRota = 0;
+
+    auto trabalhador = [&]() {
+        std::vector<double> distancia(numVertices, INF);
+        std::vector<int32_t> arcoPai(numVertices, -1);
+        std::vector<double> carga(numVertices, 0);
+        std::vector<vertex> ordem;  // Vértices na ordem em que foram fechados
+        std::vector<double> fluxoLocal(rede.numArcos(), 0);
+        double semRotaLocal = 0;
+        ContadoresBusca contadores;
+        typedef std::pair<double, vertex> Entrada;
+        std::priority_queue<Entrada, std::vector<Entrada>, std::greater<Entrada>> fila;
+
+        for (size_t i = proxima++; i < demanda.origens.size(); i = proxima++) {
+            vertex origem = demanda.origens[i];
+            distancia[origem] = 0;
+            fila.push({0, origem});
+            ESTAT_CONTAR(contadores, buscas);
+            ESTAT_CONTAR(contadores, insercoes);
+            while (!fila.empty()) {
+                auto [d, v] = fila.top();
+                fila.pop();
+                if (d > distancia[v]) continue;
+                ordem.push_back(v);
+                ESTAT_CONTAR(contadores, assentados);
+                for (int32_t arco = rede.inicio[v]; arco < rede.inicio[v + 1]; ++arco) {
+                    vertex w = rede.destino[arco];
+                    double novo = d + tempo[arco];
+                    ESTAT_CONTAR(contadores, relaxadas);
+                    if (novo < distancia[w]) {
+                        if (distancia[w] == INF) ESTAT_CONTAR(contadores, insercoes); else ESTAT_CONTAR(contadores, reducoes);
+                        distancia[w] = novo;
+                        arcoPai[w] = arco;
+                        fila.push({novo, w});
+                    }
+                }
+            }
+
+            for (int32_t k = demanda.inicio[i]; k < demanda.inicio[i + 1]; ++k) {
+                if (distancia[demanda.destino[k]] == INF) semRotaLocal += demanda.volume[k];
+                else carga[demanda.destino[k]] += demanda.volume[k];
+            }
+            // Do mais distante para a origem: cada vértice passa a sua carga para o arco pai
+            for (size_t j = ordem.size(); j-- > 1;) {
+                vertex v = ordem[j];
+                if (carga[v] > 0) {
+                    int32_t arco = arcoPai[v];
+                    fluxoLocal[arco] += carga[v];
+                    carga[rede.origem[arco]] += carga[v];
+                    carga[v] = 0;
+                }
+            }
+            for (vertex v : ordem) {
+                distancia[v] = INF;
+                arcoPai[v] = -1;
+                carga[v] = 0;
+            }
+            ordem.clear();
+        }
+
+        ESTAT_REGISTRAR_BUSCA("tudo_ou_nada", contadores);
+        std::lock_guard<std::mutex> lock(mutexFluxo);
+        for (int a = 0; a < rede.numArcos(); ++a) fluxo[a] += fluxoLocal[a];
+        semRota += semRotaLocal;
+    };
+
+    std::vector<std::thread> threads;
+    for (int t = 1; t < numThreads; ++t) threads.emplace_back(trabalhador);
+    trabalhador();
+    for (auto& t : threads) t.join();
+    return semRota;
+}
+
+// Tempo BPR de um arco com o fluxo dado
+double tempoBPR(double tempoLivre, double fluxo, const ParametrosAtribuicao& p) {
+    return tempoLivre * (1 + p.alfa * std::pow(fluxo / p.capacidade, p.beta));
+}
+
+}  // namespace
+
+ResultadoAtribuicao atribuirTrafego(const Graph& graph, const std::vector<ViagemOD>& viagens,
+                                    const ParametrosAtribuicao& parametros) {
+    ResultadoAtribuicao resultado;
+    RedeAtribuicao rede(graph, parametros.transporte);
+    DemandaPorOrigem demanda(viagens, graph.getNumVertices(), parametros.veiculosPorViagem);
+    const int numArcos = rede.numArcos();
+    int numThreads = parametros.numThreads > 0 ? parametros.numThreads : std::max(1u, std::thread::hardware_concurrency());
+    numThreads = std::max(1, std::min<int>(numThreads, demanda.origens.size()));
+
+    std::vector<double> fluxo(numArcos, 0), direcao(numArcos, 0), tempo(rede.tempoLivre);
+    resultado.volumeSemRota = tudoOuNada(rede, demanda, tempo, numThreads, fluxo);
+
+    auto atualizarTempos = [&](const std::vector<double>& x) {
+        for (int a = 0; a < numArcos; ++a) tempo[a] = tempoBPR(rede.tempoLivre[a], x[a], parametros);
+    };
+
+    for (int k = 1; k <= parametros.maxIteracoes; ++k) {
+        atualizarTempos(fluxo);
+        tudoOuNada(rede, demanda, tempo, numThreads, direcao);
+        resultado.iteracoes = k;
+
+        // Gap relativo: quanto o tempo total atual excede o de mandar todos pelos caminhos mínimos
+        double tempoAtual = 0, tempoMinimo = 0;
+        for (int a = 0; a < numArcos; ++a) {
+            tempoAtual += tempo[a] * fluxo[a];
+            tempoMinimo += tempo[a] * direcao[a];
+        }
+        resultado.gapRelativo = tempoAtual > 0 ? (tempoAtual - tempoMinimo) / tempoAtual : 0;
+        if (resultado.gapRelativo < parametros.gapAlvo) break;
+
+        double passo;
+        if (parametros.msa) {
+            passo = 1.0 / (k + 1);
+        } else {
+            // Busca em linha: a derivada da função objetivo de Beckmann ao longo de (direcao - fluxo)
+            // é crescente, então a bisseção acha o zero em [0, 1]
+            double baixo = 0, alto = 1;
+            for (int iteracao = 0; iteracao < 30; ++iteracao) {
+                double meio = (baixo + alto) / 2;
+                double derivada = 0;
+                for (int a = 0; a < numArcos; ++a) {
+                    double delta = direcao[a] - fluxo[a];
+                    if (delta != 0) derivada += delta * tempoBPR(rede.tempoLivre[a], fluxo[a] + meio * delta, parametros);
+                }
+                (derivada > 0 ? alto : baixo) = meio;
+            }
+            passo = (baixo + alto) / 2;
+        }
+        for (int a = 0; a < numArcos; ++a) fluxo[a] += passo * (direcao[a] - fluxo[a]);
+    }
+    atualizarTempos(fluxo);
+
+    resultado.fluxo.assign(graph.getNumEdgeIds(), 0);
+    resultado.tempo.assign(graph.getNumEdgeIds(), 0);
+    for (int id = 0; id < graph.getNumEdgeIds(); ++id) {
+        if (Edge* edge = graph.getEdgeById(id)) resultado.tempo[id] = edge->time_cost();
+    }
+    for (int a = 0; a < numArcos; ++a) {
+        resultado.tempoTotal += tempo[a] * fluxo[a];
+        for (int id : rede.arestas[a]) {
+            resultado.fluxo[id] = fluxo[a];
+            resultado.tempo[id] = tempo[a];
+        }
+    }
+    return resultado;
+}
+
+void aplicarTemposCongestionados(Graph& graph, const ResultadoAtribuicao& resultado, TravelProfiles* perfis) {
+    for (int id = 0; id < (int)resultado.tempo.size() && id < graph.getNumEdgeIds(); ++id) {
+        Edge* edge = graph.getEdgeById(id);
+        if (edge && edge->time_cost() != resultado.tempo[id]) graph.setEdgeTimeCost(id, resultado.tempo[id]);
+    }
+    if (perfis) {
+        perfis->revalidar(graph);
+    }
+}
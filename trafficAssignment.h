@@ -0,0 +1,46 @@
+#ifndef TRAFFICASSIGNMENT_H
+#define TRAFFICASSIGNMENT_H
+
+#include <limits>
+#include <string>
+#include <vector>
+#include "graph.h"
+#include "demand.h"
+
+class TravelProfiles;
+
+struct ParametrosAtribuicao {
+    std::string transporte = "taxi";  // Tipo de aresta da rede de veículos
+    double capacidade = 600;          // Veículos por hora em cada rua
+    double alfa = 0.15;               // BPR: t = t0 * (1 + alfa * (fluxo / capacidade)^beta)
+    double beta = 4;
+    double veiculosPorViagem = 1;     // Volume de cada par origem-destino
+    int maxIteracoes = 50;
+    double gapAlvo = 1e-4;            // Gap relativo de convergência
+    bool msa = false;                 // Passo 1/(k+1) (MSA) em vez da busca em linha de Frank-Wolfe
+    int numThreads = 0;               // <= 0 usa todos os núcleos
+};
+
+struct ResultadoAtribuicao {
+    int iteracoes = 0;
+    double gapRelativo = std::numeric_limits<double>::infinity();
+    double tempoTotal = 0;           // Soma de fluxo * tempo nas ruas (veículo-segundo)
+    double volumeSemRota = 0;        // Volume de pares sem caminho na rede
+    std::vector<double> fluxo;       // Por id de aresta (arestas paralelas repetem o fluxo da rua; 0 fora da rede)
+    std::vector<double> tempo;       // Tempo congestionado por id de aresta (time_cost original fora da rede)
+};
+
+// Atribuição de tráfego de equilíbrio do usuário por Frank-Wolfe (ou MSA). Cada iteração carrega
+// toda a demanda nos caminhos mínimos com os tempos atuais (tudo-ou-nada, uma árvore de Dijkstra
+// por origem, origens divididas entre as threads com buffers de fluxo próprios) e move o fluxo
+// na direção dessa carga. Os tempos livres são os time_cost das arestas do tipo `transporte`.
+ResultadoAtribuicao atribuirTrafego(const Graph& graph, const std::vector<ViagemOD>& viagens,
+                                    const ParametrosAtribuicao& parametros = ParametrosAtribuicao());
+
+// Grava os tempos congestionados como time_cost das arestas da rede (incrementa a versão do grafo).
+// As buscas multimodais usam o time_cost das arestas de taxi, então as rotas seguintes já os consideram.
+// Com perfis, as arestas cujo perfil de horário deixou de respeitar FIFO com o novo tempo voltam
+// ao tempo constante (TravelProfiles::revalidar).
+void aplicarTemposCongestionados(Graph& graph, const ResultadoAtribuicao& resultado, TravelProfiles* perfis = nullptr);
+
+#endif // TRAFFICASSIGNMENT_H
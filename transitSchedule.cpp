@@ -0,0 +1,448 @@
+#include "transitSchedule.h"
+#include "ssspCache.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace {
+
+// Tolerância nos horários: viagens que partem no mesmo minuto da chegada ainda podem ser pegas
+const double EPS_HORARIO = 1e-9;
+
+// Origem do rótulo de uma parada em uma rodada
+struct OrigemRotulo {
+    int8_t tipo;             // -1: herdado da rodada anterior, 0: acesso, 1: linha, 2: caminhada entre paradas
+    int32_t linha;
+    int32_t paradaAnterior;  // Parada de embarque (tipo 1) ou de início da caminhada (tipo 2)
+    double partida;
+};
+
+} // namespace
+
+std::vector<LinhaTransporte> linhasDoMetro(const std::vector<Edge*>& tuneis, const std::vector<vertex>& estacoes,
+                                           double intervalo, double primeiraPartida, double ultimaPartida) {
+    std::vector<LinhaTransporte> linhas;
+
+    // Adjacência da árvore de túneis: (vizinho, índice do túnel)
+    std::unordered_map<vertex, std::vector<std::pair<vertex, int>>> adjacencia;
+    std::vector<vertex> vertices;
+    for (int i = 0; i < (int)tuneis.size(); ++i) {
+        Edge* edge = tuneis[i];
+        if (!edge) continue;
+        for (vertex v : {edge->v1(), edge->v2()}) {
+            if (!adjacencia.count(v)) vertices.push_back(v);
+        }
+        adjacencia[edge->v1()].push_back({edge->v2(), i});
+        adjacencia[edge->v2()].push_back({edge->v1(), i});
+    }
+    std::sort(vertices.begin(), vertices.end());
+
+    // Paradas: estações e ramificações da árvore
+    std::unordered_set<vertex> ehParada(estacoes.begin(), estacoes.end());
+    for (const auto& par : adjacencia) {
+        if (par.second.size() >= 3) ehParada.insert(par.first);
+    }
+
+    std::vector<char> usado(tuneis.size(), 0);
+
+    // Vértice mais distante de v pelos túneis ainda não usados (pai guarda o caminho)
+    std::unordered_map<vertex, std::pair<vertex, int>> pai;
+    auto maisDistante = [&](vertex v) {
+        pai.clear();
+        pai[v] = {-1, -1};
+        std::vector<std::pair<vertex, double>> pilha{{v, 0.0}};
+        vertex melhor = v;
+        double melhorDistancia = 0;
+        while (!pilha.empty()) {
+            auto [u, d] = pilha.back();
+            pilha.pop_back();
+            if (d > melhorDistancia) {
+                melhorDistancia = d;
+                melhor = u;
+            }
+            for (const auto& [w, i] : adjacencia[u]) {
+                if (usado[i] || pai.count(w)) continue;
+                pai[w] = {u, i};
+                pilha.push_back({w, d + tuneis[i]->distance()});
+            }
+        }
+        return melhor;
+    };
+
+    // Decomposição em caminhos: o maior caminho da parte ainda não coberta vira a próxima linha
+    for (vertex inicio : vertices) {
+        while (true) {
+            bool temLivre = false;
+            for (const auto& vizinho : adjacencia[inicio]) {
+                if (!usado[vizinho.second]) temLivre = true;
+            }
+            if (!temLivre) break;
+
+            vertex a = maisDistante(inicio);
+            vertex b = maisDistante(a);
+
+            // Caminho de a até b, marcando os túneis como usados
+            std::vector<vertex> caminho{b};
+            std::vector<double> tempos{0.0};
+            for (vertex v = b; pai[v].first != -1; v = pai[v].first) {
+                int i = pai[v].second;
+                usado[i] = 1;
+                caminho.push_back(pai[v].first);
+                tempos.push_back(tempos.back() + calcularTempo(*tuneis[i], MODO_METRO));
+            }
+
+            LinhaTransporte ida{"Metro " + std::to_string(linhas.size() / 2 + 1), MODO_METRO, {}, {}, intervalo, primeiraPartida, ultimaPartida};
+            for (size_t j = 0; j < caminho.size(); ++j) {
+                if (j == 0 || j + 1 == caminho.size() || ehParada.count(caminho[j])) {
+                    ida.paradas.push_back(caminho[j]);
+                    ida.tempoDesdeInicio.push_back(tempos[j]);
+                }
+            }
+
+            // Sentido contrário: mesmas paradas, tempos medidos a partir da outra ponta
+            LinhaTransporte volta = ida;
+            volta.nome += " (volta)";
+            std::reverse(volta.paradas.begin(), volta.paradas.end());
+            double total = ida.tempoDesdeInicio.back();
+            for (size_t j = 0; j < volta.paradas.size(); ++j) {
+                volta.tempoDesdeInicio[j] = total - ida.tempoDesdeInicio[ida.paradas.size() - 1 - j];
+            }
+
+            linhas.push_back(ida);
+            linhas.push_back(volta);
+        }
+    }
+    return linhas;
+}
+
+LinhaTransporte linhaDeOnibusCircular(Graph& graph, const std::vector<vertex>& ciclo,
+                                      double intervalo, double primeiraPartida, double ultimaPartida) {
+    LinhaTransporte linha{"Onibus circular", MODO_ONIBUS, {}, {}, intervalo, primeiraPartida, ultimaPartida};
+    if (ciclo.size() < 2) return linha;
+
+    SsspCache& cache = SsspCache::compartilhado();
+    linha.paradas.push_back(ciclo[0]);
+    linha.tempoDesdeInicio.push_back(0.0);
+    for (size_t i = 1; i <= ciclo.size(); ++i) {
+        vertex de = ciclo[i - 1];
+        vertex para = ciclo[i % ciclo.size()];
+        int distancia = cache.distancia(graph, de, para);
+        if (distancia == INT_MAX) {
+            std::cerr << "Sem caminho entre as paradas " << de << " e " << para << std::endl;
+            linha.paradas.clear();
+            linha.tempoDesdeInicio.clear();
+            return linha;
+        }
+        linha.paradas.push_back(para);
+        linha.tempoDesdeInicio.push_back(linha.tempoDesdeInicio.back() + (distancia / 12.0) / 60.0);
+    }
+    return linha;
+}
+
+int TransitSchedule::adicionarLinha(const LinhaTransporte& linha) {
+    if (linha.paradas.size() < 2 || linha.paradas.size() != linha.tempoDesdeInicio.size() || !(linha.intervalo > 0)) {
+        std::cerr << "Linha " << linha.nome << " inválida" << std::endl;
+        return -1;
+    }
+    m_linhas.push_back(linha);
+    return m_linhas.size() - 1;
+}
+
+void TransitSchedule::preparar(const Graph& graph, double maxCaminhada, uint8_t modosAcesso) {
+    m_maxCaminhada = maxCaminhada;
+    m_numVertices = graph.getNumVertices();
+
+    // Índice compacto das paradas
+    m_paradaDoVertice.assign(m_numVertices, -1);
+    m_verticeParada.clear();
+    for (const LinhaTransporte& linha : m_linhas) {
+        for (vertex v : linha.paradas) {
+            if (m_paradaDoVertice[v] == -1) {
+                m_paradaDoVertice[v] = m_verticeParada.size();
+                m_verticeParada.push_back(v);
+            }
+        }
+    }
+    int numParadas = m_verticeParada.size();
+
+    // Paradas e tempos de cada linha, contíguos
+    m_inicioLinha.assign(1, 0);
+    m_paradasLinha.clear();
+    m_tempoLinha.clear();
+    for (const LinhaTransporte& linha : m_linhas) {
+        for (size_t j = 0; j < linha.paradas.size(); ++j) {
+            m_paradasLinha.push_back(m_paradaDoVertice[linha.paradas[j]]);
+            m_tempoLinha.push_back(linha.tempoDesdeInicio[j]);
+        }
+        m_inicioLinha.push_back(m_paradasLinha.size());
+    }
+
+    // Linhas de cada parada (contagem e preenchimento)
+    m_inicioParada.assign(numParadas + 1, 0);
+    for (int32_t p : m_paradasLinha) m_inicioParada[p + 1]++;
+    for (int p = 0; p < numParadas; ++p) m_inicioParada[p + 1] += m_inicioParada[p];
+    m_linhaDaParada.assign(m_paradasLinha.size(), 0);
+    m_posicaoNaLinha.assign(m_paradasLinha.size(), 0);
+    std::vector<int32_t> proximo(m_inicioParada.begin(), m_inicioParada.end() - 1);
+    for (int l = 0; l < (int)m_linhas.size(); ++l) {
+        for (int32_t j = m_inicioLinha[l]; j < m_inicioLinha[l + 1]; ++j) {
+            int32_t p = m_paradasLinha[j];
+            m_linhaDaParada[proximo[p]] = l;
+            m_posicaoNaLinha[proximo[p]] = j - m_inicioLinha[l];
+            proximo[p]++;
+        }
+    }
+
+    // Ruas de acesso (CSR direto e reverso)
+    std::vector<std::vector<std::pair<vertex, double>>> direta(m_numVertices), reversa(m_numVertices);
+    for (vertex v = 0; v < m_numVertices; ++v) {
+        for (Edge* edge = graph.getEdges(v); edge; edge = edge->next()) {
+            ModoTransporte modo = modoDaAresta(edge->transport_type());
+            if (modo == MODO_DESCONHECIDO || !(modosAcesso & (1 << modo))) continue;
+            double tempo = calcularTempo(*edge, modo);
+            direta[v].push_back({edge->otherVertex(v), tempo});
+            reversa[edge->otherVertex(v)].push_back({v, tempo});
+        }
+    }
+    auto montarCsr = [this](const std::vector<std::vector<std::pair<vertex, double>>>& lista, std::vector<int32_t>& inicio,
+                            std::vector<int32_t>& destino, std::vector<double>& tempo) {
+        inicio.assign(1, 0);
+        destino.clear();
+        tempo.clear();
+        for (vertex v = 0; v < m_numVertices; ++v) {
+            for (const auto& arco : lista[v]) {
+                destino.push_back(arco.first);
+                tempo.push_back(arco.second);
+            }
+            inicio.push_back(destino.size());
+        }
+    };
+    montarCsr(direta, m_inicioRua, m_destinoRua, m_tempoRua);
+    montarCsr(reversa, m_inicioRuaReversa, m_destinoRuaReversa, m_tempoRuaReversa);
+
+    // Caminhadas entre paradas próximas
+    m_inicioTransferencia.assign(1, 0);
+    m_destinoTransferencia.clear();
+    m_tempoTransferencia.clear();
+    std::vector<double> tempo(m_numVertices, std::numeric_limits<double>::infinity());
+    std::vector<vertex> tocados;
+    for (int p = 0; p < numParadas; ++p) {
+        tempoDeAcesso(m_verticeParada[p], false, tempo, tocados);
+        for (vertex v : tocados) {
+            int q = m_paradaDoVertice[v];
+            if (q != -1 && q != p) {
+                m_destinoTransferencia.push_back(q);
+                m_tempoTransferencia.push_back(tempo[v]);
+            }
+            tempo[v] = std::numeric_limits<double>::infinity();
+        }
+        m_inicioTransferencia.push_back(m_destinoTransferencia.size());
+    }
+}
+
+void TransitSchedule::tempoDeAcesso(vertex v, bool reverso, std::vector<double>& tempo, std::vector<vertex>& tocados) const {
+    const std::vector<int32_t>& inicio = reverso ? m_inicioRuaReversa : m_inicioRua;
+    const std::vector<int32_t>& destino = reverso ? m_destinoRuaReversa : m_destinoRua;
+    const std::vector<double>& tempoArco = reverso ? m_tempoRuaReversa : m_tempoRua;
+
+    tocados.clear();
+    typedef std::pair<double, vertex> Item;
+    std::priority_queue<Item, std::vector<Item>, std::greater<Item>> fila;
+    tempo[v] = 0;
+    tocados.push_back(v);
+    fila.push({0.0, v});
+    while (!fila.empty()) {
+        auto [t, u] = fila.top();
+        fila.pop();
+        if (t > tempo[u]) continue;
+        for (int32_t a = inicio[u]; a < inicio[u + 1]; ++a) {
+            double novo = t + tempoArco[a];
+            vertex w = destino[a];
+            if (novo > m_maxCaminhada || novo >= tempo[w]) continue;
+            if (tempo[w] == std::numeric_limits<double>::infinity()) tocados.push_back(w);
+            tempo[w] = novo;
+            fila.push({novo, w});
+        }
+    }
+}
+
+ResultadoTransito TransitSchedule::consultar(vertex origem, vertex destino, double partida, int maxEmbarques) const {
+    ResultadoTransito resultado;
+    if (origem < 0 || origem >= m_numVertices || destino < 0 || destino >= m_numVertices) {
+        return resultado;
+    }
+    if (origem == destino) {
+        resultado.chegada = partida;
+        return resultado;
+    }
+
+    const double INF = std::numeric_limits<double>::infinity();
+    int numParadas = m_verticeParada.size();
+    int numLinhas = m_linhas.size();
+
+    // Acesso às paradas a partir da origem e caminhada direta até o destino
+    std::vector<double> tempo(m_numVertices, INF);
+    std::vector<vertex> tocados;
+    std::vector<double> rotulo((size_t)(maxEmbarques + 1) * numParadas, INF);
+    std::vector<OrigemRotulo> origemRotulo((size_t)(maxEmbarques + 1) * numParadas, OrigemRotulo{-1, -1, -1, 0});
+    std::vector<double> melhor(numParadas, INF);
+    std::vector<int32_t> marcadas;
+    std::vector<char> marcada(numParadas, 0);
+
+    tempoDeAcesso(origem, false, tempo, tocados);
+    double chegadaDestino = partida + tempo[destino];
+    for (vertex v : tocados) {
+        int p = m_paradaDoVertice[v];
+        if (p != -1) {
+            rotulo[p] = melhor[p] = partida + tempo[v];
+            origemRotulo[p] = OrigemRotulo{0, -1, -1, partida};
+            marcada[p] = 1;
+            marcadas.push_back(p);
+        }
+        tempo[v] = INF;
+    }
+
+    // Saída: tempo de cada parada até o destino
+    tempoDeAcesso(destino, true, tempo, tocados);
+    std::vector<double> saida(numParadas, INF);
+    for (vertex v : tocados) {
+        int p = m_paradaDoVertice[v];
+        if (p != -1) saida[p] = tempo[v];
+    }
+
+    int rodadaDestino = -1, paradaDestino = -1;
+
+    // Caminhadas entre paradas a partir das paradas melhoradas na rodada k. Cada parada melhorada
+    // por caminhada também é propagada, então trechos a pé podem encadear várias transferências.
+    auto caminhar = [&](int k) {
+        double* atual = &rotulo[(size_t)k * numParadas];
+        OrigemRotulo* origemAtual = &origemRotulo[(size_t)k * numParadas];
+        for (size_t i = 0; i < marcadas.size(); ++i) {
+            int32_t p = marcadas[i];
+            for (int32_t a = m_inicioTransferencia[p]; a < m_inicioTransferencia[p + 1]; ++a) {
+                int32_t q = m_destinoTransferencia[a];
+                double chegada = atual[p] + m_tempoTransferencia[a];
+                if (chegada < melhor[q] && chegada < chegadaDestino) {
+                    atual[q] = melhor[q] = chegada;
+                    origemAtual[q] = OrigemRotulo{2, -1, p, atual[p]};
+                    marcada[q] = 1;
+                    marcadas.push_back(q);  // Pode repetir: a parada é propagada de novo com o tempo menor
+                }
+            }
+        }
+    };
+
+    // Destino: saindo de alguma parada melhorada e caminhando até lá
+    auto chegarAoDestino = [&](int k) {
+        const double* atual = &rotulo[(size_t)k * numParadas];
+        for (int32_t p : marcadas) {
+            if (atual[p] + saida[p] < chegadaDestino) {
+                chegadaDestino = atual[p] + saida[p];
+                rodadaDestino = k;
+                paradaDestino = p;
+            }
+        }
+    };
+
+    caminhar(0);
+    chegarAoDestino(0);
+    std::vector<int32_t> primeiraPosicao(numLinhas, INT_MAX);
+    std::vector<int32_t> linhasMarcadas;
+
+    for (int k = 1; k <= maxEmbarques && !marcadas.empty(); ++k) {
+        double* anterior = &rotulo[(size_t)(k - 1) * numParadas];
+        double* atual = &rotulo[(size_t)k * numParadas];
+        OrigemRotulo* origemAtual = &origemRotulo[(size_t)k * numParadas];
+        std::copy(anterior, anterior + numParadas, atual);
+
+        // Linhas que passam por paradas melhoradas na rodada anterior, a partir da primeira delas
+        linhasMarcadas.clear();
+        for (int32_t p : marcadas) {
+            for (int32_t i = m_inicioParada[p]; i < m_inicioParada[p + 1]; ++i) {
+                int32_t l = m_linhaDaParada[i];
+                if (primeiraPosicao[l] == INT_MAX) linhasMarcadas.push_back(l);
+                primeiraPosicao[l] = std::min(primeiraPosicao[l], m_posicaoNaLinha[i]);
+            }
+            marcada[p] = 0;
+        }
+        marcadas.clear();
+
+        // Varre cada linha seguindo a viagem mais cedo que dá para pegar
+        for (int32_t l : linhasMarcadas) {
+            const LinhaTransporte& linha = m_linhas[l];
+            double inicioViagem = INF;  // Partida da viagem atual na primeira parada da linha
+            int32_t embarque = -1;
+            double partidaEmbarque = 0;
+            for (int32_t j = m_inicioLinha[l] + primeiraPosicao[l]; j < m_inicioLinha[l + 1]; ++j) {
+                int32_t p = m_paradasLinha[j];
+                double t = m_tempoLinha[j];
+
+                if (inicioViagem < INF) {
+                    double chegada = inicioViagem + t;
+                    if (chegada < melhor[p] && chegada < chegadaDestino) {
+                        atual[p] = melhor[p] = chegada;
+                        origemAtual[p] = OrigemRotulo{1, l, embarque, partidaEmbarque};
+                        if (!marcada[p]) {
+                            marcada[p] = 1;
+                            marcadas.push_back(p);
+                        }
+                    }
+                }
+
+                // Chegando a p antes da viagem atual, talvez dê para pegar uma viagem anterior
+                if (anterior[p] < INF && anterior[p] <= inicioViagem + t) {
+                    double n = std::ceil((anterior[p] - t - linha.primeiraPartida) / linha.intervalo - EPS_HORARIO);
+                    double inicio = linha.primeiraPartida + std::max(0.0, n) * linha.intervalo;
+                    if (inicio <= linha.ultimaPartida + EPS_HORARIO && inicio < inicioViagem) {
+                        inicioViagem = inicio;
+                        embarque = p;
+                        partidaEmbarque = inicio + t;
+                    }
+                }
+            }
+            primeiraPosicao[l] = INT_MAX;
+        }
+
+        caminhar(k);
+
+        chegarAoDestino(k);
+    }
+
+    if (chegadaDestino == INF) return resultado;
+    resultado.chegada = chegadaDestino;
+
+    if (rodadaDestino == -1) {
+        resultado.trechos.push_back({-1, origem, destino, partida, chegadaDestino});
+        return resultado;
+    }
+
+    // Reconstrói os trechos do destino até a origem
+    int k = rodadaDestino;
+    int32_t p = paradaDestino;
+    if (m_verticeParada[p] != destino) {
+        resultado.trechos.push_back({-1, m_verticeParada[p], destino, rotulo[(size_t)k * numParadas + p], chegadaDestino});
+    }
+    while (true) {
+        while (k > 0 && origemRotulo[(size_t)k * numParadas + p].tipo == -1) k--;
+        const OrigemRotulo& o = origemRotulo[(size_t)k * numParadas + p];
+        double chegada = rotulo[(size_t)k * numParadas + p];
+        if (o.tipo == 0) {
+            if (m_verticeParada[p] != origem) {
+                resultado.trechos.push_back({-1, origem, m_verticeParada[p], partida, chegada});
+            }
+            break;
+        }
+        resultado.trechos.push_back({o.tipo == 1 ? o.linha : -1, m_verticeParada[o.paradaAnterior], m_verticeParada[p], o.partida, chegada});
+        if (o.tipo == 1) {
+            resultado.embarques++;
+            k--;
+        }
+        p = o.paradaAnterior;
+    }
+    std::reverse(resultado.trechos.begin(), resultado.trechos.end());
+    return resultado;
+}
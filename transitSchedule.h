@@ -0,0 +1,97 @@
+#ifndef TRANSITSCHEDULE_H
+#define TRANSITSCHEDULE_H
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+#include "graph.h"
+#include "fastRoute.h"
+
+// Linha com horário: sequência de paradas percorrida por viagens que saem da primeira parada
+// a cada `intervalo` minutos entre `primeiraPartida` e `ultimaPartida` (minutos do dia)
+struct LinhaTransporte {
+    std::string nome;
+    ModoTransporte modo;
+    std::vector<vertex> paradas;
+    std::vector<double> tempoDesdeInicio;  // Minutos da primeira parada até cada parada
+    double intervalo;
+    double primeiraPartida;
+    double ultimaPartida;
+};
+
+// Trecho de uma viagem: linha -1 é caminhada (ou taxi, se permitido no acesso)
+struct TrechoTransito {
+    int linha;
+    vertex origem;
+    vertex destino;
+    double partida;
+    double chegada;
+};
+
+struct ResultadoTransito {
+    double chegada = std::numeric_limits<double>::infinity();  // Minuto do dia (infinito se não houver)
+    int embarques = 0;
+    std::vector<TrechoTransito> trechos;
+};
+
+// Linhas de metrô a partir dos túneis de escavacaoMetro: a árvore é decomposta em caminhos
+// (o mais longo primeiro) e cada caminho vira uma linha nos dois sentidos. Param nas estações,
+// nas pontas e nos vértices onde a árvore se ramifica (para permitir baldeação).
+std::vector<LinhaTransporte> linhasDoMetro(const std::vector<Edge*>& tuneis, const std::vector<vertex>& estacoes,
+                                           double intervalo = 5.0, double primeiraPartida = 300.0, double ultimaPartida = 1440.0);
+
+// Linha circular de ônibus pelas paradas na ordem do ciclo (volta à primeira parada)
+LinhaTransporte linhaDeOnibusCircular(Graph& graph, const std::vector<vertex>& ciclo,
+                                      double intervalo = 10.0, double primeiraPartida = 300.0, double ultimaPartida = 1440.0);
+
+// Motor RAPTOR sobre as linhas com horário. Cada rodada estende as viagens em mais um embarque,
+// varrendo as linhas marcadas em arrays contíguos; entre rodadas, caminhadas curtas entre paradas.
+// Acesso à primeira parada e saída da última usam as ruas do Graph (caminhada por padrão).
+class TransitSchedule {
+public:
+    int adicionarLinha(const LinhaTransporte& linha);
+    const LinhaTransporte& getLinha(int i) const { return m_linhas[i]; }
+    int getNumLinhas() const { return m_linhas.size(); }
+    int getNumParadas() const { return m_verticeParada.size(); }
+
+    // Monta os arrays da consulta: paradas, linhas por parada, ruas de acesso e caminhadas entre
+    // paradas de até maxCaminhada minutos. Deve ser chamada depois de adicionar as linhas.
+    void preparar(const Graph& graph, double maxCaminhada = 10.0, uint8_t modosAcesso = 1 << MODO_WALK);
+
+    // Chegada mais cedo saindo de origem no minuto `partida`, com no máximo maxEmbarques embarques
+    ResultadoTransito consultar(vertex origem, vertex destino, double partida, int maxEmbarques = 4) const;
+
+private:
+    // Dijkstra limitado nas ruas de acesso (reverso = chegando ao vértice)
+    void tempoDeAcesso(vertex v, bool reverso, std::vector<double>& tempo, std::vector<vertex>& tocados) const;
+
+    std::vector<LinhaTransporte> m_linhas;
+    double m_maxCaminhada = 10.0;
+    int m_numVertices = 0;
+
+    // Paradas: índice compacto de cada vértice usado por alguma linha
+    std::vector<int32_t> m_paradaDoVertice;
+    std::vector<vertex> m_verticeParada;
+
+    // Paradas de cada linha: [m_inicioLinha[l], m_inicioLinha[l + 1])
+    std::vector<int32_t> m_inicioLinha;
+    std::vector<int32_t> m_paradasLinha;
+    std::vector<double> m_tempoLinha;
+
+    // Linhas que passam em cada parada, com a posição da parada na linha
+    std::vector<int32_t> m_inicioParada;
+    std::vector<int32_t> m_linhaDaParada;
+    std::vector<int32_t> m_posicaoNaLinha;
+
+    // Caminhadas entre paradas
+    std::vector<int32_t> m_inicioTransferencia;
+    std::vector<int32_t> m_destinoTransferencia;
+    std::vector<double> m_tempoTransferencia;
+
+    // Ruas de acesso em CSR, nos dois sentidos
+    std::vector<int32_t> m_inicioRua, m_destinoRua, m_inicioRuaReversa, m_destinoRuaReversa;
+    std::vector<double> m_tempoRua, m_tempoRuaReversa;
+};
+
+#endif // TRANSITSCHEDULE_H
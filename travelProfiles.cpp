@@ -0,0 +1,146 @@
+#include "travelProfiles.h"
+#include "fastRoute.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+uint64_t hashPontos(const std::vector<float>& minutos, const std::vector<float>& fatores) {
+    // FNV-1a sobre os bits dos pontos
+    uint64_t h = 1469598103934665603ULL;
+    auto misturar = [&h](float x) {
+        uint32_t bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+        h = (h ^ bits) * 1099511628211ULL;
+    };
+    for (size_t i = 0; i < minutos.size(); ++i) {
+        misturar(minutos[i]);
+        misturar(fatores[i]);
+    }
+    return h;
+}
+
+} // namespace
+
+int TravelProfiles::adicionarPerfil(Pontos pontos) {
+    if (pontos.empty()) return -1;
+    std::sort(pontos.begin(), pontos.end());
+    std::vector<float> minutos, fatores;
+    for (const auto& ponto : pontos) {
+        if (ponto.first < 0 || ponto.first >= MINUTOS_DIA || !(ponto.second > 0)) {
+            std::cerr << "Perfil inválido: ponto (" << ponto.first << ", " << ponto.second << ")" << std::endl;
+            return -1;
+        }
+        if (!minutos.empty() && (float)ponto.first == minutos.back()) {
+            std::cerr << "Perfil inválido: dois pontos no minuto " << ponto.first << std::endl;
+            return -1;
+        }
+        minutos.push_back((float)ponto.first);
+        fatores.push_back((float)ponto.second);
+    }
+
+    // Perfil idêntico já registrado: reaproveita
+    uint64_t h = hashPontos(minutos, fatores);
+    auto faixa = m_porHash.equal_range(h);
+    for (auto it = faixa.first; it != faixa.second; ++it) {
+        int p = it->second;
+        if (std::equal(minutos.begin(), minutos.end(), m_minutos.begin() + m_inicio[p], m_minutos.begin() + m_inicio[p + 1]) &&
+            std::equal(fatores.begin(), fatores.end(), m_fatores.begin() + m_inicio[p], m_fatores.begin() + m_inicio[p + 1])) {
+            return p;
+        }
+    }
+
+    // Menor inclinação, incluindo o segmento que atravessa a meia-noite
+    float menor = 0;
+    size_t k = minutos.size();
+    for (size_t i = 0; i < k && k > 1; ++i) {
+        size_t j = (i + 1) % k;
+        double dt = (j == 0) ? minutos[0] + MINUTOS_DIA - minutos[i] : minutos[j] - minutos[i];
+        menor = std::min(menor, (float)((fatores[j] - fatores[i]) / dt));
+    }
+
+    int id = getNumPerfis();
+    m_minutos.insert(m_minutos.end(), minutos.begin(), minutos.end());
+    m_fatores.insert(m_fatores.end(), fatores.begin(), fatores.end());
+    m_inicio.push_back(m_minutos.size());
+    m_menorInclinacao.push_back(menor);
+    m_porHash.emplace(h, id);
+    return id;
+}
+
+bool TravelProfiles::atribuir(const Graph& graph, int edgeId, int perfil) {
+    Edge* edge = graph.getEdgeById(edgeId);
+    if (!edge || perfil < -1 || perfil >= getNumPerfis()) {
+        std::cerr << "Aresta " << edgeId << " ou perfil " << perfil << " inexistente" << std::endl;
+        return false;
+    }
+
+    if (perfil != -1 && !respeitaFifo(*edge, perfil)) {
+        std::cerr << "Perfil " << perfil << " viola FIFO na aresta " << edgeId << std::endl;
+        return false;
+    }
+
+    if (edgeId >= (int)m_perfilAresta.size()) {
+        m_perfilAresta.resize(graph.getNumEdgeIds(), -1);
+    }
+    m_perfilAresta[edgeId] = perfil;
+    return true;
+}
+
+int TravelProfiles::revalidar(const Graph& graph) {
+    int removidos = 0;
+    for (int id = 0; id < (int)m_perfilAresta.size(); ++id) {
+        int perfil = m_perfilAresta[id];
+        if (perfil == -1) continue;
+        Edge* edge = graph.getEdgeById(id);
+        if (!edge || !respeitaFifo(*edge, perfil)) {
+            m_perfilAresta[id] = -1;
+            removidos++;
+        }
+    }
+    if (removidos > 0) {
+        std::cerr << removidos << " aresta(s) perderam o perfil de horário por violar FIFO" << std::endl;
+    }
+    return removidos;
+}
+
+bool TravelProfiles::respeitaFifo(const Edge& edge, int perfil) const {
+    // Chegada = t + base * f(t) precisa ser não decrescente: base * f'(t) >= -1
+    ModoTransporte modo = modoDaAresta(edge.transport_type());
+    double base = (modo == MODO_DESCONHECIDO) ? 0.0 : calcularTempo(edge, modo);
+    return base * m_menorInclinacao[perfil] >= -1.0;
+}
+
+double TravelProfiles::fator(int perfil, double minuto) const {
+    const float* minutos = m_minutos.data() + m_inicio[perfil];
+    const float* fatores = m_fatores.data() + m_inicio[perfil];
+    int k = m_inicio[perfil + 1] - m_inicio[perfil];
+    if (k == 1) return fatores[0];
+
+    double m = std::fmod(minuto, MINUTOS_DIA);
+    if (m < 0) m += MINUTOS_DIA;
+
+    // Segmento [a, b] que contém m; antes do primeiro ponto ou depois do último, o segmento
+    // liga o último ponto ao primeiro do dia seguinte
+    int i = std::upper_bound(minutos, minutos + k, (float)m) - minutos;
+    double ta, fa, tb, fb;
+    if (i == 0) {
+        ta = minutos[k - 1] - MINUTOS_DIA; fa = fatores[k - 1];
+        tb = minutos[0]; fb = fatores[0];
+    } else if (i == k) {
+        ta = minutos[k - 1]; fa = fatores[k - 1];
+        tb = minutos[0] + MINUTOS_DIA; fb = fatores[0];
+    } else {
+        ta = minutos[i - 1]; fa = fatores[i - 1];
+        tb = minutos[i]; fb = fatores[i];
+    }
+    return fa + (fb - fa) * (m - ta) / (tb - ta);
+}
+
+size_t TravelProfiles::bytes() const {
+    return m_inicio.capacity() * sizeof(int32_t) + m_minutos.capacity() * sizeof(float) +
+           m_fatores.capacity() * sizeof(float) + m_menorInclinacao.capacity() * sizeof(float) +
+           m_porHash.size() * (sizeof(uint64_t) + sizeof(int) + 2 * sizeof(void*)) +
+           m_perfilAresta.capacity() * sizeof(int32_t);
+}
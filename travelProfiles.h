@@ -0,0 +1,60 @@
+#ifndef TRAVELPROFILES_H
+#define TRAVELPROFILES_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <unordered_map>
+#include "graph.h"
+
+// Perfis de tempo de viagem por hora do dia. Um perfil é uma função linear por partes e periódica
+// (24 h) que multiplica o tempo estático da aresta (calcularTempo): fator 2 às 8h = trânsito com o
+// dobro do tempo. Os perfis ficam em um pool compartilhado e deduplicado (todas as arestas de
+// taxi de uma região podem apontar para o mesmo perfil); cada aresta guarda só o id do perfil,
+// -1 para tempo constante.
+class TravelProfiles {
+public:
+    static constexpr double MINUTOS_DIA = 1440.0;
+
+    // Pontos (minuto do dia, fator): minutos em [0, 1440), fatores > 0
+    typedef std::vector<std::pair<double, double>> Pontos;
+
+    // Registra o perfil (ou devolve o id de um idêntico já registrado). -1 se os pontos forem inválidos.
+    int adicionarPerfil(Pontos pontos);
+
+    // Associa o perfil à aresta (perfil -1 volta ao tempo constante). Falha se o perfil violar FIFO
+    // para essa aresta: sair mais tarde nunca pode fazer chegar mais cedo.
+    bool atribuir(const Graph& graph, int edgeId, int perfil);
+
+    // Confere FIFO de novo em todas as arestas com perfil, com os tempos atuais do grafo (o tempo de
+    // taxi muda com setEdgeTimeCost, ex. em aplicarTemposCongestionados). As arestas que passaram a
+    // violar voltam ao tempo constante. Devolve quantas voltaram.
+    int revalidar(const Graph& graph);
+
+    int perfilDaAresta(int edgeId) const {
+        return (edgeId >= 0 && edgeId < (int)m_perfilAresta.size()) ? m_perfilAresta[edgeId] : -1;
+    }
+
+    // Fator do perfil no minuto (qualquer valor; é reduzido ao dia)
+    double fator(int perfil, double minuto) const;
+    double fatorAresta(int edgeId, double minuto) const {
+        int perfil = perfilDaAresta(edgeId);
+        return perfil == -1 ? 1.0 : fator(perfil, minuto);
+    }
+
+    int getNumPerfis() const { return (int)m_inicio.size() - 1; }
+    size_t bytes() const;
+
+private:
+    bool respeitaFifo(const Edge& edge, int perfil) const;
+
+    // Pool: pontos do perfil p em [m_inicio[p], m_inicio[p + 1])
+    std::vector<int32_t> m_inicio{0};
+    std::vector<float> m_minutos;
+    std::vector<float> m_fatores;
+    std::vector<float> m_menorInclinacao;  // Menor derivada do fator (por minuto) em cada perfil
+    std::unordered_multimap<uint64_t, int> m_porHash;  // Deduplicação
+    std::vector<int32_t> m_perfilAresta;  // Indexado por Edge::id()
+};
+
+#endif // TRAVELPROFILES_H